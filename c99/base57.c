@@ -1,26 +1,50 @@
-#include "base57.h"
+#ifndef _WIN32
+#define _DEFAULT_SOURCE // posix_memalign() and madvise()
+#endif
+
+#include "base57inline.h"
 
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#define HAS_SSE2
+#endif
 
 
 const char* const base57_version = "0.1.0";
 
+static size_t streaming_threshold = (size_t)8 << 20;
 
-#define BASE 57
-#define LENGTH_OF(a) (sizeof(a) / sizeof((a)[0]))
 
+void base57_set_streaming_threshold(size_t threshold) {
+#if defined(__GNUC__)
+    __atomic_store_n(&streaming_threshold, threshold, __ATOMIC_RELAXED);
+#else
+    *(volatile size_t*)&streaming_threshold = threshold;
+#endif
+}
 
-const char SYMBOLS[8*BASE] =
-        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
-        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
-        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
-        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
-        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
-        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
-        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
-        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
-    ;
+
+size_t base57_get_streaming_threshold(void) {
+#if defined(__GNUC__)
+    return __atomic_load_n(&streaming_threshold, __ATOMIC_RELAXED);
+#else
+    return *(volatile const size_t*)&streaming_threshold;
+#endif
+}
+
+
+#define BASE 57
 
 
 static inline
@@ -36,12 +60,12 @@ uint64_t get_little_endian_uint(const uint8_t* bytes, size_t length) {
 
 
 static const uint8_t BYTE_ORDER_TEST[8] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
-static const uint64_t LITTLE_ENDIAN = 0x7766554433221100ull;
+static const uint64_t LITTLE_ENDIAN_UINT64 = 0x7766554433221100ull;
 
 
 static inline
 uint64_t get_little_endian_uint64(const uint8_t bytes[sizeof(uint64_t)]) {
-    if (*(uint64_t*)BYTE_ORDER_TEST == LITTLE_ENDIAN) {
+    if (*(uint64_t*)BYTE_ORDER_TEST == LITTLE_ENDIAN_UINT64) {
         return *(uint64_t*)bytes;
     }
     return ((uint64_t)bytes[0] <<  0)
@@ -69,7 +93,7 @@ void put_little_endian_uint(uint8_t* bytes, size_t length, uint64_t value) {
 
 static inline
 void put_little_endian_uint64(uint8_t bytes[sizeof(uint64_t)], uint64_t value) {
-    if (*(uint64_t*)BYTE_ORDER_TEST == LITTLE_ENDIAN) {
+    if (*(uint64_t*)BYTE_ORDER_TEST == LITTLE_ENDIAN_UINT64) {
         *(uint64_t*)bytes = value;
         return;
     }
@@ -112,179 +136,134 @@ size_t base57_calculate_encoded_length(size_t plain_length) {
 
 
 char* base57_encode_uint64(char output[base57_ENCODED_UINT64_SIZE + 1], uint64_t input) {
-    uint64_t value;
-    uint64_t shift = 0;
-
-    #define STEP57(I) do { \
-        value = input % 57; \
-        input /= 57; \
-        assert(shift + value < LENGTH_OF(SYMBOLS)); \
-        output[I] = SYMBOLS[shift + value]; \
-    } while (false)
-
-    #define STEP56(I) do { \
-        shift += value + 1; \
-        value = input % 56; \
-        input /= 56; \
-        assert(shift + value < LENGTH_OF(SYMBOLS)); \
-        output[I] = SYMBOLS[shift + value]; \
-    } while (false)
-
-    STEP57(0);
-    STEP56(1);
-    STEP57(2);
-    STEP56(3);
-    STEP57(4);
-    STEP56(5);
-    STEP56(6);
-    STEP57(7);
-    STEP56(8);
-    STEP57(9);
-    STEP56(10);
-    output[11] = 0;
-    return output;
-
-    #undef STEP56
-    #undef STEP57
+    return base57_inline_encode_uint64(output, input);
 }
 
 
-char* base57_encode(char* output, const uint8_t* input, size_t input_length) {
-    char * const initial_output = output;
+static char* encode_lines(char* output, const uint8_t* input, size_t input_length) {
     while (input_length > ENCODED_UINT64S_PER_LINE * sizeof(uint64_t)) {
         for (int i = 0; i < ENCODED_UINT64S_PER_LINE; ++i) {
-            base57_encode_uint64(output, get_little_endian_uint64(input));
+            base57_inline_encode_uint64(output, get_little_endian_uint64(input));
             input += sizeof(uint64_t);
             output += base57_ENCODED_UINT64_SIZE;
         }
         input_length -= ENCODED_UINT64S_PER_LINE * sizeof(uint64_t);
         *(output++) = '\n';
     }
-    while (input_length >= sizeof(uint64_t)) {
-        base57_encode_uint64(output, get_little_endian_uint64(input));
+    while (input_length > sizeof(uint64_t)) {
+        base57_inline_encode_uint64(output, get_little_endian_uint64(input));
         input += sizeof(uint64_t);
         input_length -= sizeof(uint64_t);
         output += base57_ENCODED_UINT64_SIZE;
     }
-    if (input_length > 0) {
+    if (input_length > 0) { // through a buffer, so no NUL is written after the output
         char buffer[base57_ENCODED_UINT64_SIZE + 1];
-        base57_encode_uint64(buffer, get_little_endian_uint(input, input_length));
+        base57_inline_encode_uint64(buffer, get_little_endian_uint(input, input_length));
         memcpy(output, buffer, PLAIN_TO_ENCODED_LENGTH_MAPPING[input_length]);
         output += PLAIN_TO_ENCODED_LENGTH_MAPPING[input_length];
     }
-    *output = 0;
-    return initial_output;
+    return output;
 }
 
 
-static const uint64_t MAGNITUDES[base57_ENCODED_UINT64_SIZE] = {
-    1ull,
-    1ull * 57,
-    1ull * 57 * 56,
-    1ull * 57 * 56 * 57,
-    1ull * 57 * 56 * 57 * 56,
-    1ull * 57 * 56 * 57 * 56 * 57,
-    1ull * 57 * 56 * 57 * 56 * 57 * 56,
-    1ull * 57 * 56 * 57 * 56 * 57 * 56 * 56,
-    1ull * 57 * 56 * 57 * 56 * 57 * 56 * 56 * 57,
-    1ull * 57 * 56 * 57 * 56 * 57 * 56 * 56 * 57 * 56,
-    1ull * 57 * 56 * 57 * 56 * 57 * 56 * 56 * 57 * 56 * 57,
-//     A    r    A    r    A    r    r    A    r    A    r
-};
+char* base57_encode_unterminated(char* output, const uint8_t* input, size_t input_length) {
+    if (input_length >= base57_get_streaming_threshold()) {
+        return base57_encode_streaming(output, input, input_length);
+    }
+    return encode_lines(output, input, input_length);
+}
 
 
-#define DELIMITER 57
+char* base57_encode(char* output, const uint8_t* input, size_t input_length) {
+    *base57_encode_unterminated(output, input, input_length) = 0;
+    return output;
+}
 
-/** 0, O, 1, l and I are invalid */
-static const uint8_t SYMBOL_VALUES[256] = {
-    //         x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, xA, xB, xC, xD, xE, xF
-    //         \0,                         \a, \b, \t, \n, \v, \f, \r,
-    /* 0x0x */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 57, 57, 57, 57, 57, 99, 99, /* 0x0x */
-    /* 0x1x */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 57, 57, 57, 57, /* 0x1x */
-    //           ,  !,  ",  #,  $,  %   &,  ',  (,  ),  *,  +,  ,,  -,  .,  /,
-    /* 0x2x */ 57, 99, 99, 99, 99, 99, 99, 57, 99, 99, 99, 57, 57, 57, 57, 57, /* 0x2x */
-    //          0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  :,  ;,  <,  =,  >,  ?,
-    /* 0x3x */ 99, 99,  2,  3,  4,  5,  6,  7,  8,  9, 57, 57, 99, 99, 99, 99, /* 0x3x */
-    //          @,  A,  B,  C,  D,  E,  F,  G,  H,  I,  J,  K,  L,  M,  N,  O,
-    /* 0x4x */ 99, 35, 36, 37, 38, 39, 40, 41, 42, 99, 43, 44, 45, 46, 47, 99, /* 0x4x */
-    //          P,  Q,  R,  S,  T,  U,  V,  W,  X,  Y,  Z,  [,  \,  ],  ^,  _,
-    /* 0x5x */ 48, 49, 50, 51, 52, 53, 54, 55, 56,  1,  0, 99, 57, 99, 99, 57, /* 0x5x */
-    //          `,  a,  b,  c,  d,  e,  f,  g,  h,  i,  j,  k,  l,  m,  n,  o,
-    /* 0x6x */ 57, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 99, 21, 22, 23, /* 0x6x */
-    //          p,  q,  r,  s,  t,  u,  v,  w,  x,  y,  z,  {,  |,  },  ~,
-    /* 0x7x */ 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 99, 99, 99, 99, 99, /* 0x7x */
-    //         x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, xA, xB, xC, xD, xE, xF
-    /* 0x8x */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0x8x */
-    /* 0x9x */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0x9x */
-    /* 0xAx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xAx */
-    /* 0xBx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xBx */
-    /* 0xCx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xCx */
-    /* 0xDx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xDx */
-    /* 0xEx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xEx */
-    /* 0xFx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99  /* 0xFx */
-};
 
+#define ENCODED_LINE_LENGTH (ENCODED_UINT64S_PER_LINE * base57_ENCODED_UINT64_SIZE + 1)
 
-static const uint8_t REMAINDERS_OF_57[10 * 57] = {
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
-    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
-};
 
+static inline size_t encoded_word_offset(size_t word) {
+    return word / ENCODED_UINT64S_PER_LINE * ENCODED_LINE_LENGTH
+         + word % ENCODED_UINT64S_PER_LINE * base57_ENCODED_UINT64_SIZE;
+}
 
-uint64_t base57_decode_uint64(char input[base57_ENCODED_UINT64_SIZE]) {
-    static const uint64_t L = LENGTH_OF(REMAINDERS_OF_57) - 2 * 57;
-    uint64_t svalue;
-    uint64_t value;
-    uint64_t result = 0;
-    uint64_t shift = 0;
-
-    #define STEP57(I) do { \
-        svalue = SYMBOL_VALUES[(uint8_t)input[I]]; \
-        value = REMAINDERS_OF_57[L + svalue - shift]; \
-        result += value * MAGNITUDES[I]; \
-    } while (false)
-
-    #define STEP56(I) do { \
-        shift += value + 1; \
-        svalue = SYMBOL_VALUES[(uint8_t)input[I]]; \
-        assert(L + svalue - shift < LENGTH_OF(REMAINDERS_OF_57)); \
-        value = REMAINDERS_OF_57[L + svalue - shift]; \
-        result += value * MAGNITUDES[I]; \
-    } while (false)
-
-    STEP57(0);
-    STEP56(1);
-    STEP57(2);
-    STEP56(3);
-    STEP57(4);
-    STEP56(5);
-    STEP56(6);
-    STEP57(7);
-    STEP56(8);
-    STEP57(9);
-    STEP56(10);
-    return result;
 
-    #undef STEP56
-    #undef STEP57
+static void reencode_words(
+    char* encoded, const uint8_t* plain, size_t plain_length, size_t first_word, size_t end_word
+) {
+    const size_t full_words = plain_length / sizeof(uint64_t);
+    char buffer[base57_ENCODED_UINT64_SIZE + 1];
+    for (size_t word = first_word; word < end_word; ++word) {
+        const uint8_t* input = plain + word * sizeof(uint64_t);
+        char* output = encoded + encoded_word_offset(word);
+        if (word < full_words) {
+            base57_inline_encode_uint64(buffer, get_little_endian_uint64(input));
+            memcpy(output, buffer, base57_ENCODED_UINT64_SIZE);
+        } else {
+            const size_t remains = plain_length % sizeof(uint64_t);
+            base57_inline_encode_uint64(buffer, get_little_endian_uint(input, remains));
+            memcpy(output, buffer, PLAIN_TO_ENCODED_LENGTH_MAPPING[remains]);
+        }
+    }
+}
+
+
+static inline bool is_valid_range(size_t plain_length, base57_Range range) {
+    return range.offset <= plain_length && range.length <= plain_length - range.offset;
+}
+
+
+static inline void reencode_range(
+    char* encoded, const uint8_t* plain, size_t plain_length, base57_Range range
+) {
+    if (range.length == 0) {
+        return;
+    }
+    const size_t first_word = range.offset / sizeof(uint64_t);
+    const size_t end_word = (range.offset + range.length + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    reencode_words(encoded, plain, plain_length, first_word, end_word);
+}
+
+
+bool base57_reencode_range(
+    char* encoded, size_t encoded_length, const uint8_t* plain, size_t plain_length,
+    size_t dirty_offset, size_t dirty_length
+) {
+    const base57_Range range = { dirty_offset, dirty_length };
+    if (encoded_length != base57_calculate_encoded_length(plain_length)
+            || !is_valid_range(plain_length, range)) {
+        return false;
+    }
+    reencode_range(encoded, plain, plain_length, range);
+    return true;
+}
+
+
+bool base57_reencode_ranges(
+    char* encoded, size_t encoded_length, const uint8_t* plain, size_t plain_length,
+    const base57_Range* dirty_ranges, size_t dirty_ranges_number
+) {
+    if (encoded_length != base57_calculate_encoded_length(plain_length)) {
+        return false;
+    }
+    for (size_t i = 0; i < dirty_ranges_number; ++i) {
+        if (!is_valid_range(plain_length, dirty_ranges[i])) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < dirty_ranges_number; ++i) {
+        reencode_range(encoded, plain, plain_length, dirty_ranges[i]);
+    }
+    return true;
+}
+
+
+#define DELIMITER 57
+
+
+uint64_t base57_decode_uint64(char input[base57_ENCODED_UINT64_SIZE]) {
+    return base57_inline_decode_uint64(input);
 }
 
 
@@ -295,11 +274,11 @@ size_t base57_calculate_decoded_max_length(size_t encoded_length) {
 }
 
 
-void base57_decode_part(
+static void decode_part(
     uint8_t** output, base57_DecodingBuffer* buffer, const char** input, size_t* input_length
 ) {
     while (*input_length > 0) {
-        uint8_t v = SYMBOL_VALUES[(uint8_t)**input];
+        uint8_t v = base57_SYMBOL_VALUES[(uint8_t)**input];
         if (v >= BASE) {
             if (v != DELIMITER) {
                 return;
@@ -313,7 +292,7 @@ void base57_decode_part(
         *input += 1;
         *input_length -= 1;
         if (buffer->symbols_number >= base57_ENCODED_UINT64_SIZE) {
-            put_little_endian_uint64(*output, base57_decode_uint64(buffer->symbols));
+            put_little_endian_uint64(*output, base57_inline_decode_uint64(buffer->symbols));
             buffer->symbols_number = 0;
             *output += sizeof(uint64_t);
         }
@@ -321,17 +300,691 @@ void base57_decode_part(
 }
 
 
+void base57_decode_part(
+    uint8_t** output, base57_DecodingBuffer* buffer, const char** input, size_t* input_length
+) {
+    if (*input_length >= base57_get_streaming_threshold()) {
+        base57_decode_part_streaming(output, buffer, input, input_length);
+        return;
+    }
+    decode_part(output, buffer, input, input_length);
+}
+
+
 void base57_flush_decoding_buffer(uint8_t** output, base57_DecodingBuffer* buffer) {
     assert(buffer->symbols_number < base57_ENCODED_UINT64_SIZE);
     if (buffer->symbols_number > 0) {
-        uint64_t svalue = SYMBOL_VALUES[buffer->symbols[buffer->symbols_number - 1]];
+        uint64_t svalue = base57_SYMBOL_VALUES[buffer->symbols[buffer->symbols_number - 1]];
         assert(svalue < BASE);
         for (uint8_t i = buffer->symbols_number; i < base57_ENCODED_UINT64_SIZE; ++i) {
-            buffer->symbols[i] = SYMBOLS[++svalue];
+            buffer->symbols[i] = base57_SYMBOLS[++svalue];
         }
-        uint64_t value = base57_decode_uint64(buffer->symbols) % MAGNITUDES[buffer->symbols_number];
+        uint64_t value = base57_inline_decode_uint64(buffer->symbols) % base57_MAGNITUDES[buffer->symbols_number];
         put_little_endian_uint(*output, ENCODED_TO_PLAIN_LENGTH_MAPPING[buffer->symbols_number], value);
         *output += ENCODED_TO_PLAIN_LENGTH_MAPPING[buffer->symbols_number];
     }
     memset(buffer, 0, sizeof(*buffer));
 }
+
+
+/// Writes a word into the current line unless \c output_capacity is too small.
+static inline bool put_encoded_uint64(
+    char** output, size_t* output_capacity, base57_EncodingBuffer* buffer, uint64_t value, size_t length
+) {
+    const size_t separator = buffer->line_uint64s >= ENCODED_UINT64S_PER_LINE;
+    if (*output_capacity < separator + length) {
+        return false;
+    }
+    if (separator) {
+        *((*output)++) = '\n';
+        buffer->line_uint64s = 0;
+    }
+    buffer->line_uint64s += 1;
+    char symbols[base57_ENCODED_UINT64_SIZE + 1];
+    base57_inline_encode_uint64(symbols, value);
+    memcpy(*output, symbols, length);
+    *output += length;
+    *output_capacity -= separator + length;
+    return true;
+}
+
+
+static void encode_part(
+    char** output, size_t* output_capacity, base57_EncodingBuffer* buffer,
+    const uint8_t** input, size_t* input_length
+) {
+    if (buffer->bytes_number > 0) {
+        size_t taken = sizeof(uint64_t) - buffer->bytes_number;
+        if (taken > *input_length) {
+            taken = *input_length;
+        }
+        memcpy(buffer->bytes + buffer->bytes_number, *input, taken);
+        buffer->bytes_number += (uint8_t)taken;
+        *input += taken;
+        *input_length -= taken;
+        if (buffer->bytes_number < sizeof(uint64_t)) {
+            return;
+        }
+        if (!put_encoded_uint64(
+                output, output_capacity, buffer, get_little_endian_uint64(buffer->bytes), base57_ENCODED_UINT64_SIZE
+        )) {
+            return;
+        }
+        buffer->bytes_number = 0;
+    }
+    while (*input_length >= sizeof(uint64_t)) {
+        if (buffer->line_uint64s >= ENCODED_UINT64S_PER_LINE) {
+            // whole lines, each one takes its leading '\n' and 88 symbols
+            size_t lines = *input_length / (ENCODED_UINT64S_PER_LINE * sizeof(uint64_t));
+            const size_t fitting_lines = *output_capacity / ENCODED_LINE_LENGTH;
+            if (lines > fitting_lines) {
+                lines = fitting_lines;
+            }
+            if (lines > 0) {
+                const size_t plain_length = lines * ENCODED_UINT64S_PER_LINE * sizeof(uint64_t);
+                *((*output)++) = '\n';
+                *output = encode_lines(*output, *input, plain_length);
+                *output_capacity -= lines * ENCODED_LINE_LENGTH;
+                *input += plain_length;
+                *input_length -= plain_length;
+                continue;
+            }
+        }
+        if (!put_encoded_uint64(
+                output, output_capacity, buffer, get_little_endian_uint64(*input), base57_ENCODED_UINT64_SIZE
+        )) {
+            return;
+        }
+        *input += sizeof(uint64_t);
+        *input_length -= sizeof(uint64_t);
+    }
+    memcpy(buffer->bytes, *input, *input_length);
+    buffer->bytes_number = (uint8_t)*input_length;
+    *input += *input_length;
+    *input_length = 0;
+}
+
+
+void base57_encode_part_bounded(
+    char** output, size_t* output_capacity, base57_EncodingBuffer* buffer,
+    const uint8_t** input, size_t* input_length
+) {
+    encode_part(output, output_capacity, buffer, input, input_length);
+}
+
+
+bool base57_finish_encoding_bounded(char** output, size_t* output_capacity, base57_EncodingBuffer* buffer) {
+    if (buffer->bytes_number > 0) {
+        const size_t length = PLAIN_TO_ENCODED_LENGTH_MAPPING[buffer->bytes_number];
+        if (!put_encoded_uint64(
+                output, output_capacity, buffer, get_little_endian_uint(buffer->bytes, buffer->bytes_number), length
+        )) {
+            return false;
+        }
+    }
+    memset(buffer, 0, sizeof(*buffer));
+    return true;
+}
+
+
+bool base57_decode_part_bounded(
+    uint8_t** output, size_t* output_capacity, base57_DecodingBuffer* buffer,
+    const char** input, size_t* input_length
+) {
+    while (*input_length > 0) {
+        // a chunk with so many characters cannot complete more words than fit in the output
+        const size_t words = *output_capacity / sizeof(uint64_t);
+        size_t chunk = words * base57_ENCODED_UINT64_SIZE + (base57_ENCODED_UINT64_SIZE - 1) - buffer->symbols_number;
+        if (chunk > *input_length) {
+            chunk = *input_length;
+        }
+        if (chunk == 0) {
+            break;
+        }
+        size_t unprocessed = chunk;
+        uint8_t* const initial_output = *output;
+        decode_part(output, buffer, input, &unprocessed);
+        *output_capacity -= *output - initial_output;
+        *input_length -= chunk - unprocessed;
+        if (unprocessed > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool base57_flush_decoding_buffer_bounded(uint8_t** output, size_t* output_capacity, base57_DecodingBuffer* buffer) {
+    const size_t length = ENCODED_TO_PLAIN_LENGTH_MAPPING[buffer->symbols_number];
+    if (*output_capacity < length) {
+        return false;
+    }
+    base57_flush_decoding_buffer(output, buffer);
+    *output_capacity -= length;
+    return true;
+}
+
+
+#define SHIFTED_POSITIONS 0x56A // positions 1, 3, 5, 6, 8 and 10 have base 56
+#define NORMALIZING_CHUNK 4096
+
+
+size_t base57_calculate_normalized_max_length(size_t encoded_length) {
+    return (encoded_length / base57_ENCODED_UINT64_SIZE + 1) * (base57_ENCODED_UINT64_SIZE + 1);
+}
+
+
+/// Tells if base57_encode_uint64() of base57_decode_uint64() of the symbols gives the same symbols.
+/// It is so when every base 56 digit is below 56 and the value does not overflow.
+/// A shift before a base 56 digit is congruent to the previous symbol value plus one, so the digit
+/// is 56 exactly when its symbol repeats the previous one, which needs no arithmetic to check.
+/// \remark Conservative for the highest digit, a false result only costs a round trip.
+/// \pre With SSE2 16 bytes from \c symbols are readable.
+static inline bool is_canonical_uint64(const char symbols[base57_ENCODED_UINT64_SIZE]) {
+    const uint64_t L = sizeof(base57_REMAINDERS_OF_57) - 2 * 57;
+#ifdef HAS_SSE2
+    const __m128i characters = _mm_loadu_si128((const __m128i*)symbols);
+    const bool repeated = (_mm_movemask_epi8(
+        _mm_cmpeq_epi8(characters, _mm_slli_si128(characters, 1))
+    ) & SHIFTED_POSITIONS) != 0;
+#else
+    bool repeated = false;
+    for (int i = 1; i < base57_ENCODED_UINT64_SIZE; ++i) {
+        repeated |= ((SHIFTED_POSITIONS >> i) & 1) && symbols[i] == symbols[i - 1];
+    }
+#endif
+    const uint64_t highest = base57_REMAINDERS_OF_57[
+        L + base57_SYMBOL_VALUES[(uint8_t)symbols[10]] - base57_SYMBOL_VALUES[(uint8_t)symbols[9]] - 1
+    ];
+    return !repeated && highest < UINT64_MAX / base57_MAGNITUDES[base57_ENCODED_UINT64_SIZE - 1];
+}
+
+
+#ifdef HAS_SSE2
+static inline __m128i are_in_range_sse2(__m128i characters, char low, char high) {
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(characters, _mm_set1_epi8((char)(low - 1))),
+        _mm_cmplt_epi8(characters, _mm_set1_epi8((char)(high + 1)))
+    );
+}
+
+
+/// \returns a mask with a bit set for each of 16 characters which is a symbol,
+/// bytes above 0x7F are negative and out of ranges.
+static inline unsigned symbols_mask_sse2(__m128i characters) {
+    const __m128i in_ranges = _mm_or_si128(
+        are_in_range_sse2(characters, '2', '9'),
+        _mm_or_si128(are_in_range_sse2(characters, 'A', 'Z'), are_in_range_sse2(characters, 'a', 'z'))
+    );
+    const __m128i excluded = _mm_or_si128(
+        _mm_cmpeq_epi8(characters, _mm_set1_epi8('I')),
+        _mm_or_si128(_mm_cmpeq_epi8(characters, _mm_set1_epi8('O')), _mm_cmpeq_epi8(characters, _mm_set1_epi8('l')))
+    );
+    return (unsigned)_mm_movemask_epi8(_mm_andnot_si128(excluded, in_ranges));
+}
+
+
+/// \pre \c mask is not 0
+static inline unsigned count_trailing_zeros(unsigned mask) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    unsigned zeros = 0;
+    for (; (mask & 1) == 0; mask >>= 1) {
+        ++zeros;
+    }
+    return zeros;
+#endif
+}
+#endif
+
+
+/// Copies symbols from \c input to \c output skipping delimiters.
+/// A 16 character block is stored whole and the output advances over its symbols up to the first
+/// delimiter, the next block starts after the delimiter. The last block goes symbol by symbol.
+/// \returns a number of consumed characters, less than \c input_length at an invalid character.
+/// \pre \c output has room for \c input_length characters.
+static size_t compact_symbols(char** output, const char* input, size_t input_length) {
+    size_t i = 0;
+    while (i < input_length) {
+#ifdef HAS_SSE2
+        if (input_length - i >= 16) {
+            const __m128i characters = _mm_loadu_si128((const __m128i*)(input + i));
+            const unsigned symbols_mask = symbols_mask_sse2(characters);
+            _mm_storeu_si128((__m128i*)*output, characters);
+            if (symbols_mask == 0xFFFF) {
+                *output += 16;
+                i += 16;
+                continue;
+            }
+            const unsigned run = count_trailing_zeros(~symbols_mask);
+            const unsigned rest = symbols_mask >> run;
+            const unsigned skipped = rest != 0 ? count_trailing_zeros(rest) : 16 - run; // e.g. CRLF at once
+            *output += run;
+            i += run;
+            for (const size_t delimiters_end = i + skipped; i < delimiters_end; ++i) {
+                if (base57_SYMBOL_VALUES[(uint8_t)input[i]] != DELIMITER) {
+                    return i;
+                }
+            }
+            continue;
+        }
+#endif
+        const size_t block_end = input_length - i < 16 ? input_length : i + 16;
+        bool invalid = false;
+        char* block_output = *output;
+        for (size_t j = i; j < block_end; ++j) { // branchless, delimiters are overwritten
+            const uint8_t v = base57_SYMBOL_VALUES[(uint8_t)input[j]];
+            *block_output = input[j];
+            block_output += v < BASE;
+            invalid |= v > DELIMITER;
+        }
+        if (invalid) {
+            for (; base57_SYMBOL_VALUES[(uint8_t)input[i]] <= DELIMITER; ++i) {
+                *output += base57_SYMBOL_VALUES[(uint8_t)input[i]] < BASE;
+            }
+            return i;
+        }
+        *output = block_output;
+        i = block_end;
+    }
+    return i;
+}
+
+
+/// \returns the output end, \c line_uint64s is a local copy because writes through char pointers
+/// could alias it and the output pointer, so they would be reloaded after every word otherwise.
+static inline char* put_normalized_uint64(
+    char* output, uint8_t* line_uint64s, const char symbols[base57_ENCODED_UINT64_SIZE]
+) {
+    if (*line_uint64s >= ENCODED_UINT64S_PER_LINE) {
+        *(output++) = '\n';
+        *line_uint64s = 0;
+    }
+    *line_uint64s += 1;
+    if (is_canonical_uint64(symbols)) {
+        memcpy(output, symbols, base57_ENCODED_UINT64_SIZE);
+    }
+    else {
+        char reencoded[base57_ENCODED_UINT64_SIZE + 1];
+        base57_inline_encode_uint64(reencoded, base57_inline_decode_uint64(symbols));
+        memcpy(output, reencoded, base57_ENCODED_UINT64_SIZE);
+    }
+    return output + base57_ENCODED_UINT64_SIZE;
+}
+
+
+void base57_normalize_part(
+    char** output, base57_NormalizingBuffer* buffer, const char** input, size_t* input_length
+) {
+    // is_canonical_uint64() may read 16 bytes of the last word
+    char staging[base57_ENCODED_UINT64_SIZE - 1 + NORMALIZING_CHUNK + 16 - base57_ENCODED_UINT64_SIZE];
+    while (*input_length > 0) {
+        const size_t chunk = *input_length < NORMALIZING_CHUNK ? *input_length : NORMALIZING_CHUNK;
+        memcpy(staging, buffer->symbols, buffer->symbols_number);
+        char* staged = staging + buffer->symbols_number;
+        const size_t consumed = compact_symbols(&staged, *input, chunk);
+        *input += consumed;
+        *input_length -= consumed;
+        const char* symbols = staging;
+        char* normalized = *output;
+        uint8_t line_uint64s = buffer->line_uint64s;
+        for (; staged - symbols >= base57_ENCODED_UINT64_SIZE; symbols += base57_ENCODED_UINT64_SIZE) {
+            normalized = put_normalized_uint64(normalized, &line_uint64s, symbols);
+        }
+        *output = normalized;
+        buffer->line_uint64s = line_uint64s;
+        buffer->symbols_number = (uint8_t)(staged - symbols);
+        memcpy(buffer->symbols, symbols, buffer->symbols_number);
+        if (consumed < chunk) {
+            return;
+        }
+    }
+}
+
+
+void base57_flush_normalizing_buffer(char** output, base57_NormalizingBuffer* buffer) {
+    assert(buffer->symbols_number < base57_ENCODED_UINT64_SIZE);
+    if (buffer->symbols_number > 0) {
+        // a decoding and encoding round trip, a tail may change its length
+        base57_DecodingBuffer decoding_buffer = { 0 };
+        memcpy(decoding_buffer.symbols, buffer->symbols, buffer->symbols_number);
+        decoding_buffer.symbols_number = buffer->symbols_number;
+        uint8_t decoded[sizeof(uint64_t)];
+        uint8_t* decoded_end = decoded;
+        base57_flush_decoding_buffer(&decoded_end, &decoding_buffer);
+        const size_t decoded_length = decoded_end - decoded;
+        if (buffer->line_uint64s >= ENCODED_UINT64S_PER_LINE) {
+            *((*output)++) = '\n';
+        }
+        char encoded[base57_ENCODED_UINT64_SIZE + 1];
+        base57_inline_encode_uint64(encoded, get_little_endian_uint(decoded, decoded_length));
+        memcpy(*output, encoded, PLAIN_TO_ENCODED_LENGTH_MAPPING[decoded_length]);
+        *output += PLAIN_TO_ENCODED_LENGTH_MAPPING[decoded_length];
+    }
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+
+#define CACHE_LINE_SIZE 64
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)
+#define STAGING_LINES 32
+#define STAGING_PLAIN_SIZE (STAGING_LINES * ENCODED_UINT64S_PER_LINE * sizeof(uint64_t))
+#define STAGING_ENCODED_SIZE (STAGING_LINES * ENCODED_LINE_LENGTH)
+
+
+static inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+    __builtin_prefetch(address, 0, 0); // read once, no temporal locality
+#elif defined(HAS_SSE2)
+    _mm_prefetch((const char*)address, _MM_HINT_NTA);
+#else
+    (void)address;
+#endif
+}
+
+
+/// Prefetches [begin, begin + size), callers clamp the size to the end of the input.
+static inline void prefetch_range(const void* begin, size_t size) {
+    for (size_t offset = 0; offset < size; offset += CACHE_LINE_SIZE) {
+        prefetch((const char*)begin + offset);
+    }
+}
+
+
+/// Copies with non-temporal stores which bypass the cache.
+/// \remark Falls back to memcpy() when streaming stores are not available.
+static void copy_streaming(void* destination, const void* source, size_t size) {
+#ifdef HAS_SSE2
+    char* d = (char*)destination;
+    const char* s = (const char*)source;
+    size_t head = (16 - (uintptr_t)d % 16) % 16;
+    if (head > size) {
+        head = size;
+    }
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+    while (size >= 4 * 16) {
+        _mm_stream_si128((__m128i*)d + 0, _mm_loadu_si128((const __m128i*)s + 0));
+        _mm_stream_si128((__m128i*)d + 1, _mm_loadu_si128((const __m128i*)s + 1));
+        _mm_stream_si128((__m128i*)d + 2, _mm_loadu_si128((const __m128i*)s + 2));
+        _mm_stream_si128((__m128i*)d + 3, _mm_loadu_si128((const __m128i*)s + 3));
+        d += 4 * 16;
+        s += 4 * 16;
+        size -= 4 * 16;
+    }
+    while (size >= 16) {
+        _mm_stream_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+        d += 16;
+        s += 16;
+        size -= 16;
+    }
+    memcpy(d, s, size);
+#else
+    memcpy(destination, source, size);
+#endif
+}
+
+
+static inline void end_streaming() {
+#ifdef HAS_SSE2
+    _mm_sfence();
+#endif
+}
+
+
+char* base57_encode_streaming(char* output, const uint8_t* input, size_t input_length) {
+    char staging[STAGING_ENCODED_SIZE];
+    while (input_length > STAGING_PLAIN_SIZE) {
+        const size_t ahead = input_length - STAGING_PLAIN_SIZE;
+        prefetch_range(input + STAGING_PLAIN_SIZE, ahead < STAGING_PLAIN_SIZE ? ahead : STAGING_PLAIN_SIZE);
+        char* staged = encode_lines(staging, input, STAGING_PLAIN_SIZE);
+        *(staged++) = '\n';
+        copy_streaming(output, staging, staged - staging);
+        output += staged - staging;
+        input += STAGING_PLAIN_SIZE;
+        input_length -= STAGING_PLAIN_SIZE;
+    }
+    end_streaming();
+    return encode_lines(output, input, input_length);
+}
+
+
+void base57_decode_part_streaming(
+    uint8_t** output, base57_DecodingBuffer* buffer, const char** input, size_t* input_length
+) {
+    uint8_t staging[(STAGING_ENCODED_SIZE + base57_ENCODED_UINT64_SIZE) / base57_ENCODED_UINT64_SIZE * sizeof(uint64_t)];
+    while (*input_length > 0) {
+        size_t chunk = *input_length < STAGING_ENCODED_SIZE ? *input_length : STAGING_ENCODED_SIZE;
+        size_t unprocessed = chunk;
+        uint8_t* staged = staging;
+        const size_t ahead = *input_length - chunk;
+        prefetch_range(*input + chunk, ahead < STAGING_ENCODED_SIZE ? ahead : STAGING_ENCODED_SIZE);
+        decode_part(&staged, buffer, input, &unprocessed);
+        copy_streaming(*output, staging, staged - staging);
+        *output += staged - staging;
+        *input_length -= chunk - unprocessed;
+        if (unprocessed > 0) {
+            break;
+        }
+    }
+    end_streaming();
+}
+
+
+void* base57_allocate(size_t size) {
+    if (size == 0) {
+        size = 1;
+    }
+#ifdef _WIN32
+    return _aligned_malloc(size, CACHE_LINE_SIZE);
+#else
+    void* buffer = NULL;
+    size_t alignment = size >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : CACHE_LINE_SIZE;
+    if (posix_memalign(&buffer, alignment, size) != 0) {
+        return NULL;
+    }
+#ifdef MADV_HUGEPAGE
+    if (size >= HUGE_PAGE_SIZE) {
+        madvise(buffer, size - size % HUGE_PAGE_SIZE, MADV_HUGEPAGE); // only a hint
+    }
+#endif
+    return buffer;
+#endif
+}
+
+
+void base57_free(void* buffer) {
+#ifdef _WIN32
+    _aligned_free(buffer);
+#else
+    free(buffer);
+#endif
+}
+
+
+char* base57_allocate_encoded(size_t plain_length) {
+    return (char*)base57_allocate(base57_calculate_encoded_length(plain_length) + 1);
+}
+
+
+uint8_t* base57_allocate_decoded(size_t encoded_length) {
+    return (uint8_t*)base57_allocate(base57_calculate_decoded_max_length(encoded_length));
+}
+
+
+struct base57_MultiEncoder {
+    size_t streams_number;
+    base57_EncodingBuffer streams[];
+};
+
+
+struct base57_MultiDecoder {
+    size_t streams_number;
+    base57_DecodingBuffer streams[];
+};
+
+
+#define MULTI_BATCH_SIZE 64
+
+
+typedef struct DecodingJob {
+    char symbols[base57_ENCODED_UINT64_SIZE];
+    uint8_t* output;
+} DecodingJob;
+
+
+/// Words of the batch are independent, so their kernels overlap in the pipeline
+/// instead of waiting on each other as consecutive words of one stream do.
+static void decode_batch(const DecodingJob* jobs, size_t jobs_number) {
+    uint64_t values[MULTI_BATCH_SIZE];
+    for (size_t i = 0; i < jobs_number; ++i) {
+        values[i] = base57_inline_decode_uint64(jobs[i].symbols);
+    }
+    for (size_t i = 0; i < jobs_number; ++i) {
+        put_little_endian_uint64(jobs[i].output, values[i]);
+    }
+}
+
+
+base57_MultiEncoder* base57_create_multi_encoder(size_t streams_number) {
+    base57_MultiEncoder* encoder = (base57_MultiEncoder*)calloc(
+        1, sizeof(base57_MultiEncoder) + streams_number * sizeof(base57_EncodingBuffer)
+    );
+    if (encoder != NULL) {
+        encoder->streams_number = streams_number;
+    }
+    return encoder;
+}
+
+
+void base57_destroy_multi_encoder(base57_MultiEncoder* encoder) {
+    free(encoder);
+}
+
+
+size_t base57_calculate_encoded_part_max_length(size_t plain_length) {
+    return (plain_length / sizeof(uint64_t) + 1) * (base57_ENCODED_UINT64_SIZE + 1);
+}
+
+
+void base57_multi_encode_part(
+    base57_MultiEncoder* encoder, base57_EncodingSegment* segments, size_t segments_number
+) {
+    for (size_t i = 0; i < segments_number; ++i) {
+        assert(segments[i].stream < encoder->streams_number);
+        size_t unbounded = SIZE_MAX;
+        encode_part(
+            &segments[i].output, &unbounded, &encoder->streams[segments[i].stream],
+            &segments[i].input, &segments[i].input_length
+        );
+    }
+}
+
+
+void base57_multi_finish_encoding(base57_MultiEncoder* encoder, size_t stream, char** output) {
+    assert(stream < encoder->streams_number);
+    size_t unbounded = SIZE_MAX;
+    base57_finish_encoding_bounded(output, &unbounded, &encoder->streams[stream]);
+}
+
+
+base57_MultiDecoder* base57_create_multi_decoder(size_t streams_number) {
+    base57_MultiDecoder* decoder = (base57_MultiDecoder*)calloc(
+        1, sizeof(base57_MultiDecoder) + streams_number * sizeof(base57_DecodingBuffer)
+    );
+    if (decoder != NULL) {
+        decoder->streams_number = streams_number;
+    }
+    return decoder;
+}
+
+
+void base57_destroy_multi_decoder(base57_MultiDecoder* decoder) {
+    free(decoder);
+}
+
+
+static inline bool are_symbols(const char* input, size_t length) {
+    bool invalid = false;
+    for (size_t i = 0; i < length; ++i) {
+        invalid |= base57_SYMBOL_VALUES[(uint8_t)input[i]] >= BASE; // branchless, delimiters included
+    }
+    return !invalid;
+}
+
+
+/// Moves a next word of the segment to the job.
+/// \returns false if the segment ended or stopped at an invalid character without completing a word.
+static bool take_decoding_job(base57_MultiDecoder* decoder, base57_DecodingSegment* segment, DecodingJob* job) {
+    assert(segment->stream < decoder->streams_number);
+    base57_DecodingBuffer* buffer = &decoder->streams[segment->stream];
+    if (buffer->symbols_number == 0 && segment->input_length >= base57_ENCODED_UINT64_SIZE
+            && are_symbols(segment->input, base57_ENCODED_UINT64_SIZE)) {
+        memcpy(job->symbols, segment->input, base57_ENCODED_UINT64_SIZE);
+        segment->input += base57_ENCODED_UINT64_SIZE;
+        segment->input_length -= base57_ENCODED_UINT64_SIZE;
+    }
+    else {
+        while (buffer->symbols_number < base57_ENCODED_UINT64_SIZE) {
+            if (segment->input_length == 0) {
+                return false;
+            }
+            uint8_t v = base57_SYMBOL_VALUES[(uint8_t)*segment->input];
+            if (v >= BASE && v != DELIMITER) {
+                return false;
+            }
+            if (v != DELIMITER) {
+                buffer->symbols[buffer->symbols_number++] = *segment->input;
+            }
+            segment->input += 1;
+            segment->input_length -= 1;
+        }
+        memcpy(job->symbols, buffer->symbols, base57_ENCODED_UINT64_SIZE);
+        buffer->symbols_number = 0;
+    }
+    job->output = segment->output;
+    segment->output += sizeof(uint64_t);
+    return true;
+}
+
+
+void base57_multi_decode_part(
+    base57_MultiDecoder* decoder, base57_DecodingSegment* segments, size_t segments_number
+) {
+    DecodingJob jobs[MULTI_BATCH_SIZE];
+    size_t active[MULTI_BATCH_SIZE]; // indices of segments which may have more words
+    size_t active_number = 0;
+    size_t next = 0;
+    for (;;) {
+        while (active_number < MULTI_BATCH_SIZE && next < segments_number) {
+            active[active_number++] = next++;
+        }
+        if (active_number == 0) {
+            break;
+        }
+        size_t jobs_number = 0;
+        for (size_t i = 0; i < active_number;) {
+            if (take_decoding_job(decoder, &segments[active[i]], &jobs[jobs_number])) {
+                ++jobs_number;
+                ++i;
+            }
+            else { // finished segments are dropped, so rounds do not revisit them
+                active[i] = active[--active_number];
+            }
+        }
+        decode_batch(jobs, jobs_number);
+    }
+}
+
+
+void base57_multi_flush_decoding(base57_MultiDecoder* decoder, size_t stream, uint8_t** output) {
+    assert(stream < decoder->streams_number);
+    base57_flush_decoding_buffer(output, &decoder->streams[stream]);
+}
@@ -36,6 +36,36 @@ size_t base57_calculate_encoded_length(size_t plain_length);
 /// \returns \c output
 char* base57_encode(char* output, const uint8_t* input, size_t input_length);
 
+/// Encodes \c input into \c output without a NUL termination.
+/// \pre \c Output must have at least base57_calculate_encoded_length().
+/// \returns a pointer just after the written data.
+char* base57_encode_unterminated(char* output, const uint8_t* input, size_t input_length);
+
+
+typedef struct base57_Range {
+    size_t offset;
+    size_t length;
+} base57_Range;
+
+
+/// Updates \c encoded after \c plain was modified in a range of bytes.
+/// Only the words which cover the range, including a trailing partial one, are rewritten,
+/// so an update costs time proportional to the change and not to the whole data.
+/// \pre \c encoded is base57_encode() output of \c plain before the modification.
+/// \returns false if \c encoded_length does not match \c plain_length or the range is out of bounds;
+/// \c encoded is not modified then.
+bool base57_reencode_range(
+    char* encoded, size_t encoded_length, const uint8_t* plain, size_t plain_length,
+    size_t dirty_offset, size_t dirty_length
+);
+
+/// base57_reencode_range() for many dirty ranges.
+/// \returns false if any range is invalid; \c encoded is not modified then.
+bool base57_reencode_ranges(
+    char* encoded, size_t encoded_length, const uint8_t* plain, size_t plain_length,
+    const base57_Range* dirty_ranges, size_t dirty_ranges_number
+);
+
 
 /// Calculates a maximum length of decoded data for a given encoded data length.
 /// \post base57_calculate_decoded_max_length(encoded_length) <= encoded_length
@@ -79,6 +109,197 @@ void base57_decode(uint8_t** output, const char** input, size_t* input_length) {
 }
 
 
+typedef struct base57_EncodingBuffer {
+    uint8_t bytes[sizeof(uint64_t)];
+    uint8_t bytes_number;
+    uint8_t line_uint64s;
+} base57_EncodingBuffer;
+
+
+/// Stream encoding into an output of a limited capacity, e.g. a ring buffer or a send window.
+/// Encoding stops when a next word does not fit, so it can be resumed with more capacity.
+/// Output of all parts, finished with base57_finish_encoding_bounded(), is identical to
+/// base57_encode_unterminated() of the concatenated input.
+/// \param[out] buffer Must be initialized with zeros before the first call.
+/// Keeps a tail of the input shorter than a word.
+/// \param output_capacity Will be decreased by the number of written characters.
+/// \param input Will be updated to point to a first unconsumed byte.
+/// \param input_length Will be updated to indicate remaining number of bytes, 0 unless the output is full.
+void base57_encode_part_bounded(
+    char** output, size_t* output_capacity, base57_EncodingBuffer* buffer,
+    const uint8_t** input, size_t* input_length
+);
+
+/// Writes a tail kept by base57_encode_part_bounded() and resets \c buffer.
+/// \returns false if the tail does not fit, nothing is written then.
+/// \remark 12 characters are always enough.
+bool base57_finish_encoding_bounded(char** output, size_t* output_capacity, base57_EncodingBuffer* buffer);
+
+
+/// base57_decode_part() into an output of a limited capacity.
+/// Decoding stops when a next word does not fit, so it can be resumed with more capacity.
+/// \param output_capacity Will be decreased by the number of written bytes.
+/// \returns false if decoding stopped at an invalid character pointed by \c input.
+bool base57_decode_part_bounded(
+    uint8_t** output, size_t* output_capacity, base57_DecodingBuffer* buffer,
+    const char** input, size_t* input_length
+);
+
+/// base57_flush_decoding_buffer() into an output of a limited capacity.
+/// \returns false if the decoded tail does not fit, nothing is written then.
+/// \remark 7 bytes are always enough.
+bool base57_flush_decoding_buffer_bounded(uint8_t** output, size_t* output_capacity, base57_DecodingBuffer* buffer);
+
+/// Calculates a maximum length of base57_normalize() output for a given encoded data length.
+size_t base57_calculate_normalized_max_length(size_t encoded_length);
+
+
+typedef struct base57_NormalizingBuffer {
+    char symbols[base57_ENCODED_UINT64_SIZE];
+    uint8_t symbols_number;
+    uint8_t line_uint64s;
+} base57_NormalizingBuffer;
+
+
+/// Advance function for stream normalization.
+/// Rewrites encoded data with any delimiters to the base57_encode() layout without decoding:
+/// symbols are validated and compacted and a line feed is inserted after every 88 symbols.
+/// Output is identical to base57_decode_part() followed by base57_encode(), only words
+/// which are not valid encodings take a decoding and encoding round trip.
+/// \see base57_normalize() for simple use.
+/// \param[out] output Must have at least base57_calculate_normalized_max_length(input_length).
+/// Will be updated to point a character just after the written data.
+/// \param[out] buffer Must be initialized with zeros before the first call.
+/// \warning Stream normalization must end with base57_flush_normalizing_buffer() call.
+/// \param input[in] Will be updated to point to a first unprocessed character.
+/// \param input_length[in] Will be updated to indicate remaining number of characters.
+void base57_normalize_part(
+    char** output, base57_NormalizingBuffer* buffer, const char** input, size_t* input_length
+);
+
+/// \see base57_normalize_part()
+/// \param[out] output Must have at least 12 characters.
+void base57_flush_normalizing_buffer(char** output, base57_NormalizingBuffer* buffer);
+
+
+/// Normalizes \c input into \c output without a NUL termination.
+/// \pre \c Output must have at least base57_calculate_normalized_max_length(input_length).
+/// \param input Will point just after a last processed character.
+/// \param input_length Will be set to 0 on success.
+static inline
+void base57_normalize(char** output, const char** input, size_t* input_length) {
+    base57_NormalizingBuffer buffer = { 0 };
+    base57_normalize_part(output, &buffer, input, input_length);
+    if (*input_length == 0) { // no errors
+        base57_flush_normalizing_buffer(output, &buffer);
+    }
+}
+
+/// Sets a length from which inputs are encoded and decoded with base57_encode_streaming()
+/// and base57_decode_part_streaming(), 8 MiB by default. SIZE_MAX disables the streaming mode.
+/// \remark It is a process-wide setting which is safe to change concurrently with encoding.
+void base57_set_streaming_threshold(size_t threshold);
+
+/// \see base57_set_streaming_threshold()
+size_t base57_get_streaming_threshold(void);
+
+/// base57_encode_unterminated() variant for inputs far bigger than the last level cache.
+/// Lines are staged in a small buffer and written with non-temporal stores,
+/// so the output does not evict other data from the cache. Input is prefetched ahead.
+char* base57_encode_streaming(char* output, const uint8_t* input, size_t input_length);
+
+/// base57_decode_part() variant for inputs far bigger than the last level cache.
+/// \see base57_encode_streaming()
+void base57_decode_part_streaming(
+    uint8_t** output, base57_DecodingBuffer* buffer, const char** input, size_t* input_length
+);
+
+
+/// Allocates a cache line aligned buffer. Buffers of 2 MiB and more are also
+/// huge page aligned and advised to be backed by huge pages where supported.
+/// \returns NULL on failure
+/// \see base57_free()
+void* base57_allocate(size_t size);
+
+/// Frees a buffer from base57_allocate(), base57_allocate_encoded() or base57_allocate_decoded().
+void base57_free(void* buffer);
+
+/// Allocates an output for base57_encode() of \c plain_length bytes.
+char* base57_allocate_encoded(size_t plain_length);
+
+/// Allocates an output for base57_decode() of \c encoded_length characters.
+uint8_t* base57_allocate_decoded(size_t encoded_length);
+
+
+/// Calculates a maximum output length of base57_multi_encode_part() for a segment of \c plain_length bytes.
+size_t base57_calculate_encoded_part_max_length(size_t plain_length);
+
+
+/// A stream segment for the multi-stream functions.
+/// \c input, \c input_length and \c output are advanced like in base57_decode_part().
+typedef struct base57_EncodingSegment {
+    size_t stream;
+    const uint8_t* input;
+    size_t input_length;
+    char* output;
+} base57_EncodingSegment;
+
+/// \see base57_EncodingSegment
+typedef struct base57_DecodingSegment {
+    size_t stream;
+    const char* input;
+    size_t input_length;
+    uint8_t* output;
+} base57_DecodingSegment;
+
+
+/// Encoding state of many independent streams, a base57_EncodingBuffer per stream,
+/// so segments of all of them are encoded in one call.
+typedef struct base57_MultiEncoder base57_MultiEncoder;
+
+/// Decoding state of many independent streams, a base57_DecodingBuffer per stream.
+/// Segments are decoded in lockstep, a word of each stream at a time, and words of
+/// different streams are decoded in batches, so their serial kernels run interleaved.
+typedef struct base57_MultiDecoder base57_MultiDecoder;
+
+
+/// Creates an encoder of streams numbered from 0 to streams_number - 1.
+/// \returns NULL on failure
+base57_MultiEncoder* base57_create_multi_encoder(size_t streams_number);
+
+void base57_destroy_multi_encoder(base57_MultiEncoder* encoder);
+
+/// Encodes the segments, a stream may occur at most once in \c segments.
+/// Output of a stream, finished with base57_multi_finish_encoding(), is identical to
+/// base57_encode_unterminated() of the concatenated stream segments.
+/// \pre Each \c output must have at least base57_calculate_encoded_part_max_length(input_length).
+/// \post Each \c input_length is 0, a tail shorter than a word is kept in the encoder.
+void base57_multi_encode_part(
+    base57_MultiEncoder* encoder, base57_EncodingSegment* segments, size_t segments_number
+);
+
+/// Writes a kept tail of the stream and resets it, so it may be reused for a new stream.
+/// \param[out] output Must have at least 12 characters.
+void base57_multi_finish_encoding(base57_MultiEncoder* encoder, size_t stream, char** output);
+
+
+/// Creates a decoder of streams numbered from 0 to streams_number - 1.
+/// \returns NULL on failure
+base57_MultiDecoder* base57_create_multi_decoder(size_t streams_number);
+
+void base57_destroy_multi_decoder(base57_MultiDecoder* decoder);
+
+/// base57_decode_part() of each segment, a stream may occur at most once in \c segments.
+/// A segment stops at an invalid character like in base57_decode_part().
+/// \pre Each \c output must have at least 8 bytes per completed word.
+void base57_multi_decode_part(
+    base57_MultiDecoder* decoder, base57_DecodingSegment* segments, size_t segments_number
+);
+
+/// base57_flush_decoding_buffer() of the stream, it may be reused for a new stream then.
+void base57_multi_flush_decoding(base57_MultiDecoder* decoder, size_t stream, uint8_t** output);
+
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
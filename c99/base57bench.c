@@ -0,0 +1,346 @@
+#include "base57inline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+#define WORDS (1 << 24)
+#define LARGE_PLAIN_SIZE ((size_t)128 << 20)
+#define NEIGHBOUR_SIZE ((size_t)2 << 20)
+#define NEIGHBOUR_PASSES 16
+#define STREAMS 4096
+#define SEGMENT_PLAIN_SIZE 256
+#define SEGMENT_ROUNDS 64
+#define SKEWED_PLAIN_SIZE ((size_t)64 << 10)
+#define NORMALIZED_PLAIN_SIZE ((size_t)16 << 20)
+#define REWRAPPED_LINE_LENGTH 76
+
+
+/** Donald Knuth's Linear Congruential Generator */
+static inline
+uint64_t lcg(uint64_t *state) {
+    *state = 6364136223846793005ull * *state + 1442695040888963407ull;
+    return *state;
+}
+
+
+static volatile uint64_t sink;
+
+
+static double elapsed_seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+
+static void report(const char* name, size_t calls, double seconds) {
+    printf("%-32s %8.2f ns/call\n", name, 1e9 * seconds / (double)calls);
+}
+
+
+static void report_throughput(const char* name, size_t bytes, double seconds) {
+    printf("%-32s %8.2f MB/s\n", name, (double)bytes / seconds / 1e6);
+}
+
+
+static void bench_uint64_encoding() {
+    char encoded[base57_ENCODED_UINT64_SIZE + 1];
+    uint64_t lcg_state = 0x1F2E3D4C5B6A7988ull;
+    uint64_t checksum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < WORDS; ++i) {
+        base57_encode_uint64(encoded, lcg(&lcg_state));
+        checksum += (uint8_t)encoded[i % base57_ENCODED_UINT64_SIZE];
+    }
+    report("base57_encode_uint64", WORDS, elapsed_seconds(start));
+
+    lcg_state = 0x1F2E3D4C5B6A7988ull;
+    start = clock();
+    for (size_t i = 0; i < WORDS; ++i) {
+        base57_inline_encode_uint64(encoded, lcg(&lcg_state));
+        checksum -= (uint8_t)encoded[i % base57_ENCODED_UINT64_SIZE];
+    }
+    report("base57_inline_encode_uint64", WORDS, elapsed_seconds(start));
+    sink = checksum;
+}
+
+
+static void bench_uint64_decoding() {
+    char* encoded = (char*)malloc(WORDS * base57_ENCODED_UINT64_SIZE + 1);
+    uint64_t lcg_state = 0x5A6B7C8D9EAFB0C1ull;
+    for (size_t i = 0; i < WORDS; ++i) {
+        base57_inline_encode_uint64(encoded + i * base57_ENCODED_UINT64_SIZE, lcg(&lcg_state));
+    }
+    uint64_t checksum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < WORDS; ++i) {
+        checksum += base57_decode_uint64(encoded + i * base57_ENCODED_UINT64_SIZE);
+    }
+    report("base57_decode_uint64", WORDS, elapsed_seconds(start));
+
+    start = clock();
+    for (size_t i = 0; i < WORDS; ++i) {
+        checksum -= base57_inline_decode_uint64(encoded + i * base57_ENCODED_UINT64_SIZE);
+    }
+    report("base57_inline_decode_uint64", WORDS, elapsed_seconds(start));
+    sink = checksum;
+    free(encoded);
+}
+
+
+/** A cache resident workload which suffers when its data are evicted. */
+static double run_neighbour(const uint8_t* neighbour) {
+    uint64_t checksum = 0;
+    clock_t start = clock();
+    for (int pass = 0; pass < NEIGHBOUR_PASSES; ++pass) {
+        for (size_t i = 0; i < NEIGHBOUR_SIZE; i += 64) {
+            checksum += neighbour[i];
+        }
+    }
+    sink = checksum;
+    return elapsed_seconds(start);
+}
+
+
+static void bench_large_buffers(const char* mode, size_t threshold) {
+    uint8_t* plain = (uint8_t*)base57_allocate(LARGE_PLAIN_SIZE);
+    char* encoded = base57_allocate_encoded(LARGE_PLAIN_SIZE);
+    uint8_t* decoded = base57_allocate_decoded(base57_calculate_encoded_length(LARGE_PLAIN_SIZE));
+    uint8_t* neighbour = (uint8_t*)base57_allocate(NEIGHBOUR_SIZE);
+    if (plain == NULL || encoded == NULL || decoded == NULL || neighbour == NULL) {
+        fputs("Allocation failure.\n", stderr);
+        exit(1);
+    }
+    uint64_t lcg_state = 0x6D2B79F5A3C1E087ull;
+    for (size_t i = 0; i < LARGE_PLAIN_SIZE; i += sizeof(uint64_t)) {
+        *(uint64_t*)(plain + i) = lcg(&lcg_state);
+    }
+    memset(neighbour, 1, NEIGHBOUR_SIZE);
+    base57_set_streaming_threshold(threshold);
+    char name[64];
+
+    run_neighbour(neighbour);
+    double warm = run_neighbour(neighbour);
+    clock_t start = clock();
+    base57_encode(encoded, plain, LARGE_PLAIN_SIZE);
+    snprintf(name, sizeof(name), "base57_encode %s", mode);
+    report_throughput(name, LARGE_PLAIN_SIZE, elapsed_seconds(start));
+    snprintf(name, sizeof(name), "neighbour slowdown %s", mode);
+    printf("%-32s %8.2f x\n", name, run_neighbour(neighbour) / warm);
+
+    run_neighbour(neighbour);
+    const char* input = encoded;
+    size_t input_length = base57_calculate_encoded_length(LARGE_PLAIN_SIZE);
+    uint8_t* output = decoded;
+    start = clock();
+    base57_decode(&output, &input, &input_length);
+    snprintf(name, sizeof(name), "base57_decode %s", mode);
+    report_throughput(name, LARGE_PLAIN_SIZE, elapsed_seconds(start));
+    snprintf(name, sizeof(name), "neighbour slowdown %s", mode);
+    printf("%-32s %8.2f x\n", name, run_neighbour(neighbour) / warm);
+
+    base57_free(neighbour);
+    base57_free(decoded);
+    base57_free(encoded);
+    base57_free(plain);
+}
+
+
+/** Many connections which get a small segment each per round. */
+static void bench_multi_streams() {
+    const size_t segment_encoded_size = base57_calculate_encoded_length(SEGMENT_PLAIN_SIZE) + 1;
+    uint8_t* plain = (uint8_t*)malloc(STREAMS * SEGMENT_PLAIN_SIZE);
+    char* encoded = (char*)malloc(STREAMS * segment_encoded_size);
+    uint8_t* decoded = (uint8_t*)malloc(STREAMS * SEGMENT_PLAIN_SIZE);
+    base57_DecodingBuffer* buffers = (base57_DecodingBuffer*)calloc(STREAMS, sizeof(base57_DecodingBuffer));
+    base57_EncodingSegment* encoding_segments = (base57_EncodingSegment*)malloc(STREAMS * sizeof(base57_EncodingSegment));
+    base57_DecodingSegment* decoding_segments = (base57_DecodingSegment*)malloc(STREAMS * sizeof(base57_DecodingSegment));
+    base57_MultiEncoder* encoder = base57_create_multi_encoder(STREAMS);
+    base57_MultiDecoder* decoder = base57_create_multi_decoder(STREAMS);
+    if (plain == NULL || encoded == NULL || decoded == NULL || buffers == NULL
+            || encoding_segments == NULL || decoding_segments == NULL || encoder == NULL || decoder == NULL) {
+        fputs("Allocation failure.\n", stderr);
+        exit(1);
+    }
+    uint64_t lcg_state = 0x0C4E2A7F91B3D586ull;
+    for (size_t i = 0; i < STREAMS * SEGMENT_PLAIN_SIZE; i += sizeof(uint64_t)) {
+        *(uint64_t*)(plain + i) = lcg(&lcg_state);
+    }
+
+    clock_t start = clock();
+    for (int round = 0; round < SEGMENT_ROUNDS; ++round) {
+        for (size_t s = 0; s < STREAMS; ++s) {
+            base57_encode(encoded + s * segment_encoded_size, plain + s * SEGMENT_PLAIN_SIZE, SEGMENT_PLAIN_SIZE);
+        }
+    }
+    report_throughput("base57_encode per stream", SEGMENT_ROUNDS * STREAMS * SEGMENT_PLAIN_SIZE, elapsed_seconds(start));
+
+    start = clock();
+    for (int round = 0; round < SEGMENT_ROUNDS; ++round) {
+        for (size_t s = 0; s < STREAMS; ++s) {
+            base57_EncodingSegment segment = {
+                s, plain + s * SEGMENT_PLAIN_SIZE, SEGMENT_PLAIN_SIZE, encoded + s * segment_encoded_size
+            };
+            encoding_segments[s] = segment;
+        }
+        base57_multi_encode_part(encoder, encoding_segments, STREAMS);
+        for (size_t s = 0; s < STREAMS; ++s) {
+            base57_multi_finish_encoding(encoder, s, &encoding_segments[s].output);
+        }
+    }
+    report_throughput("base57_multi_encode_part", SEGMENT_ROUNDS * STREAMS * SEGMENT_PLAIN_SIZE, elapsed_seconds(start));
+
+    const size_t segment_length = segment_encoded_size - 1;
+    start = clock();
+    for (int round = 0; round < SEGMENT_ROUNDS; ++round) {
+        for (size_t s = 0; s < STREAMS; ++s) {
+            uint8_t* output = decoded + s * SEGMENT_PLAIN_SIZE;
+            const char* input = encoded + s * segment_encoded_size;
+            size_t input_length = segment_length;
+            base57_decode_part(&output, &buffers[s], &input, &input_length);
+        }
+    }
+    report_throughput("base57_decode_part per stream", SEGMENT_ROUNDS * STREAMS * SEGMENT_PLAIN_SIZE, elapsed_seconds(start));
+
+    start = clock();
+    for (int round = 0; round < SEGMENT_ROUNDS; ++round) {
+        for (size_t s = 0; s < STREAMS; ++s) {
+            base57_DecodingSegment segment = {
+                s, encoded + s * segment_encoded_size, segment_length, decoded + s * SEGMENT_PLAIN_SIZE
+            };
+            decoding_segments[s] = segment;
+        }
+        base57_multi_decode_part(decoder, decoding_segments, STREAMS);
+    }
+    report_throughput("base57_multi_decode_part", SEGMENT_ROUNDS * STREAMS * SEGMENT_PLAIN_SIZE, elapsed_seconds(start));
+    sink = decoded[lcg(&lcg_state) % (STREAMS * SEGMENT_PLAIN_SIZE)];
+
+    base57_destroy_multi_decoder(decoder);
+    base57_destroy_multi_encoder(encoder);
+    free(decoding_segments);
+    free(encoding_segments);
+    free(buffers);
+    free(decoded);
+    free(encoded);
+    free(plain);
+}
+
+
+/** One long segment among many single word ones, finished segments must not slow down the long one. */
+static void bench_skewed_multi_streams() {
+    const size_t encoded_length = base57_calculate_encoded_length(SKEWED_PLAIN_SIZE);
+    uint8_t* plain = (uint8_t*)malloc(SKEWED_PLAIN_SIZE);
+    char* encoded = (char*)malloc(encoded_length + 1);
+    uint8_t* decoded = (uint8_t*)malloc(SKEWED_PLAIN_SIZE + STREAMS * sizeof(uint64_t));
+    base57_DecodingSegment* segments = (base57_DecodingSegment*)malloc(STREAMS * sizeof(base57_DecodingSegment));
+    base57_MultiDecoder* decoder = base57_create_multi_decoder(STREAMS);
+    if (plain == NULL || encoded == NULL || decoded == NULL || segments == NULL || decoder == NULL) {
+        fputs("Allocation failure.\n", stderr);
+        exit(1);
+    }
+    uint64_t lcg_state = 0x3A91F07C5D2E64B8ull;
+    for (size_t i = 0; i < SKEWED_PLAIN_SIZE; i += sizeof(uint64_t)) {
+        *(uint64_t*)(plain + i) = lcg(&lcg_state);
+    }
+    base57_encode(encoded, plain, SKEWED_PLAIN_SIZE);
+
+    clock_t start = clock();
+    for (int round = 0; round < SEGMENT_ROUNDS; ++round) {
+        base57_DecodingSegment long_segment = { 0, encoded, encoded_length, decoded };
+        segments[0] = long_segment;
+        for (size_t s = 1; s < STREAMS; ++s) {
+            base57_DecodingSegment short_segment = {
+                s, encoded, base57_ENCODED_UINT64_SIZE, decoded + SKEWED_PLAIN_SIZE + s * sizeof(uint64_t)
+            };
+            segments[s] = short_segment;
+        }
+        base57_multi_decode_part(decoder, segments, STREAMS);
+    }
+    report_throughput(
+        "base57_multi_decode_part skewed",
+        SEGMENT_ROUNDS * (SKEWED_PLAIN_SIZE + (STREAMS - 1) * sizeof(uint64_t)), elapsed_seconds(start)
+    );
+    sink = decoded[lcg(&lcg_state) % SKEWED_PLAIN_SIZE];
+
+    base57_destroy_multi_decoder(decoder);
+    free(segments);
+    free(decoded);
+    free(encoded);
+    free(plain);
+}
+
+
+/** Data re-wrapped by another tool to CRLF lines of a different length. */
+static void bench_normalization() {
+    const size_t encoded_length = base57_calculate_encoded_length(NORMALIZED_PLAIN_SIZE);
+    uint8_t* plain = (uint8_t*)malloc(NORMALIZED_PLAIN_SIZE);
+    char* encoded = (char*)malloc(encoded_length + 1);
+    char* rewrapped = (char*)malloc(2 * encoded_length);
+    char* normalized = (char*)malloc(base57_calculate_normalized_max_length(2 * encoded_length));
+    uint8_t* decoded = (uint8_t*)malloc(base57_calculate_decoded_max_length(2 * encoded_length));
+    if (plain == NULL || encoded == NULL || rewrapped == NULL || normalized == NULL || decoded == NULL) {
+        fputs("Allocation failure.\n", stderr);
+        exit(1);
+    }
+    uint64_t lcg_state = 0x2B8E4F17C6A3D059ull;
+    for (size_t i = 0; i < NORMALIZED_PLAIN_SIZE; i += sizeof(uint64_t)) {
+        *(uint64_t*)(plain + i) = lcg(&lcg_state);
+    }
+    base57_encode(encoded, plain, NORMALIZED_PLAIN_SIZE);
+    size_t rewrapped_length = 0;
+    size_t line_length = 0;
+    for (size_t i = 0; i < encoded_length; ++i) {
+        if (encoded[i] == '\n') {
+            continue;
+        }
+        rewrapped[rewrapped_length++] = encoded[i];
+        if (++line_length == REWRAPPED_LINE_LENGTH) {
+            rewrapped[rewrapped_length++] = '\r';
+            rewrapped[rewrapped_length++] = '\n';
+            line_length = 0;
+        }
+    }
+
+    memset(normalized, 0, base57_calculate_normalized_max_length(rewrapped_length)); // no page faults in timing
+    memset(decoded, 0, base57_calculate_decoded_max_length(rewrapped_length));
+
+    clock_t start = clock();
+    char* output = normalized;
+    const char* input = rewrapped;
+    size_t input_length = rewrapped_length;
+    base57_normalize(&output, &input, &input_length);
+    report_throughput("base57_normalize", rewrapped_length, elapsed_seconds(start));
+
+    start = clock();
+    uint8_t* decoded_end = decoded;
+    input = rewrapped;
+    input_length = rewrapped_length;
+    base57_decode(&decoded_end, &input, &input_length);
+    base57_encode(normalized, decoded, decoded_end - decoded);
+    report_throughput("base57_decode + base57_encode", rewrapped_length, elapsed_seconds(start));
+
+    start = clock();
+    memcpy(normalized, rewrapped, rewrapped_length);
+    report_throughput("memcpy", rewrapped_length, elapsed_seconds(start));
+    sink = (uint8_t)normalized[lcg(&lcg_state) % encoded_length];
+
+    free(decoded);
+    free(normalized);
+    free(rewrapped);
+    free(encoded);
+    free(plain);
+}
+
+
+int main() {
+    bench_uint64_encoding();
+    bench_uint64_decoding();
+    bench_multi_streams();
+    bench_skewed_multi_streams();
+    bench_normalization();
+    const size_t threshold = base57_get_streaming_threshold();
+    bench_large_buffers("cached", SIZE_MAX);
+    bench_large_buffers("streaming", threshold);
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <string.h>
 #ifdef _WIN32
 #include <fcntl.h>
 #endif
@@ -12,6 +13,7 @@
 #define BUFFER_SIZE (1 << 15)
 static char encoded_buffer[BUFFER_SIZE];
 static uint8_t decoded_buffer[BUFFER_SIZE];
+static char normalized_buffer[(BUFFER_SIZE / base57_ENCODED_UINT64_SIZE + 2) * (base57_ENCODED_UINT64_SIZE + 1)];
 
 
 static void set_binary_output() {
@@ -41,7 +43,44 @@ static inline void write_decoded(size_t size) {
 }
 
 
-int main() {
+static inline void write_normalized(size_t size) {
+    if (fwrite(normalized_buffer, 1, size, stdout) < size) {
+        perror("Standard output writing error");
+        exit(1);
+    }
+}
+
+
+/// Rewrites encoded data with any delimiters to the canonical layout without decoding.
+static int normalize() {
+    base57_NormalizingBuffer buffer = { 0 };
+    while (true) {
+        size_t bytes_read = read_encoded();
+        char* output = normalized_buffer;
+        const char* input = encoded_buffer;
+        base57_normalize_part(&output, &buffer, &input, &bytes_read);
+        if (bytes_read > 0) {
+            fputs("Invalid Base57 symbol.\n", stderr);
+            exit(1);
+        }
+        if (feof(stdin)) {
+            base57_flush_normalizing_buffer(&output, &buffer);
+            write_normalized(output - normalized_buffer);
+            return 0;
+        }
+        write_normalized(output - normalized_buffer);
+    }
+}
+
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--normalize") == 0) {
+        return normalize();
+    }
+    if (argc > 1) {
+        fputs("Usage: base57decode [--normalize] < encoded\n", stderr);
+        return 2;
+    }
     set_binary_output();
     base57_DecodingBuffer buffer = { 0 };
     while (true) {
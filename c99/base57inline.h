@@ -0,0 +1,186 @@
+#pragma once
+
+/// Header-only word kernels.
+/// Including this header makes the 64-bit word kernels and their tables visible
+/// to the compiler so that they can be inlined into tight loops and constant-folded
+/// for known inputs. The base57 library itself is a thin wrapper around them.
+/// The tables are \c static on purpose: each translation unit gets its own copy (about 1.4 KiB),
+/// which keeps the header usable without linking the library and lets the compiler fold lookups.
+
+#include "base57.h"
+
+#include <assert.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+static const char base57_SYMBOLS[8*57 + 1] = // with the NUL, which C++ requires room for
+        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
+        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
+        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
+        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
+        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
+        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
+        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
+        "ZY23456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWX"
+    ;
+
+
+static const uint64_t base57_MAGNITUDES[base57_ENCODED_UINT64_SIZE] = {
+    1ull,
+    1ull * 57,
+    1ull * 57 * 56,
+    1ull * 57 * 56 * 57,
+    1ull * 57 * 56 * 57 * 56,
+    1ull * 57 * 56 * 57 * 56 * 57,
+    1ull * 57 * 56 * 57 * 56 * 57 * 56,
+    1ull * 57 * 56 * 57 * 56 * 57 * 56 * 56,
+    1ull * 57 * 56 * 57 * 56 * 57 * 56 * 56 * 57,
+    1ull * 57 * 56 * 57 * 56 * 57 * 56 * 56 * 57 * 56,
+    1ull * 57 * 56 * 57 * 56 * 57 * 56 * 56 * 57 * 56 * 57,
+//     A    r    A    r    A    r    r    A    r    A    r
+};
+
+
+/** 0, O, 1, l and I are invalid, 57 is a delimiter */
+static const uint8_t base57_SYMBOL_VALUES[256] = {
+    //         x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, xA, xB, xC, xD, xE, xF
+    //         \0,                         \a, \b, \t, \n, \v, \f, \r,
+    /* 0x0x */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 57, 57, 57, 57, 57, 99, 99, /* 0x0x */
+    /* 0x1x */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 57, 57, 57, 57, /* 0x1x */
+    //           ,  !,  ",  #,  $,  %   &,  ',  (,  ),  *,  +,  ,,  -,  .,  /,
+    /* 0x2x */ 57, 99, 99, 99, 99, 99, 99, 57, 99, 99, 99, 57, 57, 57, 57, 57, /* 0x2x */
+    //          0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  :,  ;,  <,  =,  >,  ?,
+    /* 0x3x */ 99, 99,  2,  3,  4,  5,  6,  7,  8,  9, 57, 57, 99, 99, 99, 99, /* 0x3x */
+    //          @,  A,  B,  C,  D,  E,  F,  G,  H,  I,  J,  K,  L,  M,  N,  O,
+    /* 0x4x */ 99, 35, 36, 37, 38, 39, 40, 41, 42, 99, 43, 44, 45, 46, 47, 99, /* 0x4x */
+    //          P,  Q,  R,  S,  T,  U,  V,  W,  X,  Y,  Z,  [,  \,  ],  ^,  _,
+    /* 0x5x */ 48, 49, 50, 51, 52, 53, 54, 55, 56,  1,  0, 99, 57, 99, 99, 57, /* 0x5x */
+    //          `,  a,  b,  c,  d,  e,  f,  g,  h,  i,  j,  k,  l,  m,  n,  o,
+    /* 0x6x */ 57, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 99, 21, 22, 23, /* 0x6x */
+    //          p,  q,  r,  s,  t,  u,  v,  w,  x,  y,  z,  {,  |,  },  ~,
+    /* 0x7x */ 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 99, 99, 99, 99, 99, /* 0x7x */
+    //         x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, xA, xB, xC, xD, xE, xF
+    /* 0x8x */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0x8x */
+    /* 0x9x */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0x9x */
+    /* 0xAx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xAx */
+    /* 0xBx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xBx */
+    /* 0xCx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xCx */
+    /* 0xDx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xDx */
+    /* 0xEx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, /* 0xEx */
+    /* 0xFx */ 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99  /* 0xFx */
+};
+
+
+static const uint8_t base57_REMAINDERS_OF_57[10 * 57] = {
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,
+    28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,
+};
+
+
+/// Inlinable variant of base57_encode_uint64().
+/// \returns NUL terminated output
+static inline
+char* base57_inline_encode_uint64(char output[base57_ENCODED_UINT64_SIZE + 1], uint64_t input) {
+    uint64_t value;
+    uint64_t shift = 0;
+
+    #define base57_STEP57(I) do { \
+        value = input % 57; \
+        input /= 57; \
+        assert(shift + value < 8*57); \
+        output[I] = base57_SYMBOLS[shift + value]; \
+    } while (false)
+
+    #define base57_STEP56(I) do { \
+        shift += value + 1; \
+        value = input % 56; \
+        input /= 56; \
+        assert(shift + value < 8*57); \
+        output[I] = base57_SYMBOLS[shift + value]; \
+    } while (false)
+
+    base57_STEP57(0);
+    base57_STEP56(1);
+    base57_STEP57(2);
+    base57_STEP56(3);
+    base57_STEP57(4);
+    base57_STEP56(5);
+    base57_STEP56(6);
+    base57_STEP57(7);
+    base57_STEP56(8);
+    base57_STEP57(9);
+    base57_STEP56(10);
+    output[11] = 0;
+    return output;
+
+    #undef base57_STEP56
+    #undef base57_STEP57
+}
+
+
+/// Inlinable variant of base57_decode_uint64().
+/// \warning Undefined value is returned for invalid input.
+static inline
+uint64_t base57_inline_decode_uint64(const char input[base57_ENCODED_UINT64_SIZE]) {
+    const uint64_t L = sizeof(base57_REMAINDERS_OF_57) - 2 * 57;
+    uint64_t svalue;
+    uint64_t value;
+    uint64_t result = 0;
+    uint64_t shift = 0;
+
+    #define base57_STEP57(I) do { \
+        svalue = base57_SYMBOL_VALUES[(uint8_t)input[I]]; \
+        value = base57_REMAINDERS_OF_57[L + svalue - shift]; \
+        result += value * base57_MAGNITUDES[I]; \
+    } while (false)
+
+    #define base57_STEP56(I) do { \
+        shift += value + 1; \
+        svalue = base57_SYMBOL_VALUES[(uint8_t)input[I]]; \
+        assert(L + svalue - shift < sizeof(base57_REMAINDERS_OF_57)); \
+        value = base57_REMAINDERS_OF_57[L + svalue - shift]; \
+        result += value * base57_MAGNITUDES[I]; \
+    } while (false)
+
+    base57_STEP57(0);
+    base57_STEP56(1);
+    base57_STEP57(2);
+    base57_STEP56(3);
+    base57_STEP57(4);
+    base57_STEP56(5);
+    base57_STEP56(6);
+    base57_STEP57(7);
+    base57_STEP56(8);
+    base57_STEP57(9);
+    base57_STEP56(10);
+    return result;
+
+    #undef base57_STEP56
+    #undef base57_STEP57
+}
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
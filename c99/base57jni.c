@@ -0,0 +1,140 @@
+/// JNI bindings for tech.surdacki.base57.NativeBackend.
+/// Direct buffers are accessed by their addresses, arrays inside critical regions.
+/// Bounds are checked on the Java side, -1 is returned when the Java side should take over.
+
+#include "base57inline.h"
+
+#include <jni.h>
+
+
+static jint encode(char* output, const uint8_t* input, size_t input_length) {
+    return (jint)(base57_encode_unterminated(output, input, input_length) - output);
+}
+
+
+/// The Java decoder rejects ASCII separators which the C one takes for delimiters.
+static bool has_separators(const char* input, size_t input_length) {
+    bool found = false;
+    for (size_t i = 0; i < input_length; ++i) {
+        found |= (uint8_t)input[i] >= 0x1C && (uint8_t)input[i] <= 0x1F;
+    }
+    return found;
+}
+
+
+static const uint8_t TAIL_LENGTHS[base57_ENCODED_UINT64_SIZE] = { 0, 1, 1, 2, 3, 3, 4, 5, 6, 6, 7 };
+
+
+/// Puts a partial word like base57_flush_decoding_buffer() and the Java decoder do,
+/// but without asserting on tails which are not valid encodings, an assertion would abort
+/// the whole JVM. Padding digits only add multiples of the magnitude, so the digits sum
+/// reduced by it is the padded word value.
+static size_t put_tail(uint8_t* output, const base57_DecodingBuffer* buffer) {
+    const uint64_t L = sizeof(base57_REMAINDERS_OF_57) - 2 * 57;
+    const unsigned shifted_positions = 0x56A;
+    uint64_t value = 0;
+    uint64_t shift = 0;
+    uint64_t digit = 0;
+    for (int i = 0; i < buffer->symbols_number; ++i) {
+        if ((shifted_positions >> i) & 1) {
+            shift += digit + 1;
+        }
+        digit = base57_REMAINDERS_OF_57[L + base57_SYMBOL_VALUES[(uint8_t)buffer->symbols[i]] - shift];
+        value += digit * base57_MAGNITUDES[i];
+    }
+    value %= base57_MAGNITUDES[buffer->symbols_number];
+    for (int i = 0; i < TAIL_LENGTHS[buffer->symbols_number]; ++i) {
+        output[i] = (uint8_t)(value >> (8 * i));
+    }
+    return TAIL_LENGTHS[buffer->symbols_number];
+}
+
+
+/// \returns -1 on an invalid symbol or when \c output_capacity is too small, Java reports both.
+static jint decode(uint8_t* output, size_t output_capacity, const char* input, size_t input_length) {
+    if (has_separators(input, input_length)) {
+        return -1;
+    }
+    uint8_t* const initial_output = output;
+    base57_DecodingBuffer buffer = { 0 };
+    if (!base57_decode_part_bounded(&output, &output_capacity, &buffer, &input, &input_length)
+            || input_length > 0 || output_capacity < TAIL_LENGTHS[buffer.symbols_number]) {
+        return -1;
+    }
+    output += put_tail(output, &buffer);
+    return (jint)(output - initial_output);
+}
+
+
+JNIEXPORT jint JNICALL Java_tech_surdacki_base57_NativeBackend_encode(
+    JNIEnv* env, jclass cls, jobject src, jint src_position, jint src_length, jobject dst, jint dst_position
+) {
+    (void)cls;
+    if (src_length == 0) {
+        return 0;
+    }
+    const uint8_t* input = (const uint8_t*)(*env)->GetDirectBufferAddress(env, src);
+    char* output = (char*)(*env)->GetDirectBufferAddress(env, dst);
+    if (input == NULL || output == NULL) {
+        return -1;
+    }
+    return encode(output + dst_position, input + src_position, (size_t)src_length);
+}
+
+
+JNIEXPORT jint JNICALL Java_tech_surdacki_base57_NativeBackend_decode(
+    JNIEnv* env, jclass cls, jobject src, jint src_position, jint src_length,
+    jobject dst, jint dst_position, jint dst_length
+) {
+    (void)cls;
+    if (src_length == 0) {
+        return 0;
+    }
+    const char* input = (const char*)(*env)->GetDirectBufferAddress(env, src);
+    uint8_t* output = (uint8_t*)(*env)->GetDirectBufferAddress(env, dst);
+    if (input == NULL || output == NULL) {
+        return -1;
+    }
+    return decode(output + dst_position, (size_t)dst_length, input + src_position, (size_t)src_length);
+}
+
+
+JNIEXPORT jint JNICALL Java_tech_surdacki_base57_NativeBackend_encodeArray(
+    JNIEnv* env, jclass cls, jbyteArray src, jint src_offset, jint src_length, jbyteArray dst, jint dst_offset
+) {
+    (void)cls;
+    uint8_t* input = (uint8_t*)(*env)->GetPrimitiveArrayCritical(env, src, NULL);
+    char* output = (char*)(*env)->GetPrimitiveArrayCritical(env, dst, NULL);
+    jint written = -1;
+    if (input != NULL && output != NULL) {
+        written = encode(output + dst_offset, input + src_offset, (size_t)src_length);
+    }
+    if (output != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, dst, output, 0);
+    }
+    if (input != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, src, input, JNI_ABORT);
+    }
+    return written;
+}
+
+
+JNIEXPORT jint JNICALL Java_tech_surdacki_base57_NativeBackend_decodeArray(
+    JNIEnv* env, jclass cls, jbyteArray src, jint src_offset, jint src_length,
+    jbyteArray dst, jint dst_offset, jint dst_length
+) {
+    (void)cls;
+    char* input = (char*)(*env)->GetPrimitiveArrayCritical(env, src, NULL);
+    uint8_t* output = (uint8_t*)(*env)->GetPrimitiveArrayCritical(env, dst, NULL);
+    jint written = -1;
+    if (input != NULL && output != NULL) {
+        written = decode(output + dst_offset, (size_t)dst_length, input + src_offset, (size_t)src_length);
+    }
+    if (output != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, dst, output, 0);
+    }
+    if (input != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, src, input, JNI_ABORT);
+    }
+    return written;
+}
@@ -242,6 +242,9 @@ static void test_bytes_encoding(const uint8_t* const plain, const size_t plain_s
     const size_t encoded_size = base57_calculate_encoded_length(plain_size);
     TEST_UINT_RELATION(2 * plain_size, >= , encoded_size);
     TEST_UINT_EQUALITY(0, encoded[encoded_size]);
+    encoded[encoded_size] = '#';
+    TEST_UINT_EQUALITY(encoded_size, base57_encode_unterminated(encoded, plain, plain_size) - encoded);
+    TEST_UINT_EQUALITY('#', encoded[encoded_size]);
     char* input = encoded;
     size_t input_length = encoded_size;
     uint8_t* output = decoded;
@@ -287,6 +290,373 @@ static void test_random_bytes_encoding(size_t max_size, size_t tests, uint64_t*
 }
 
 
+static void test_streaming_encoding(uint64_t* lcg_state) {
+    const size_t threshold = base57_get_streaming_threshold();
+    base57_set_streaming_threshold(0);
+    test_same_bytes_encoding(0x5A);
+    test_random_bytes_encoding(64 * 1024, 256, lcg_state);
+    base57_set_streaming_threshold(threshold);
+}
+
+
+static void test_large_buffers_allocation(size_t plain_size) {
+    uint8_t* plain = (uint8_t*)base57_allocate(plain_size);
+    char* encoded = base57_allocate_encoded(plain_size);
+    size_t encoded_size = base57_calculate_encoded_length(plain_size);
+    uint8_t* decoded = base57_allocate_decoded(encoded_size);
+    TEST(plain != NULL && encoded != NULL && decoded != NULL);
+    TEST_UINT_EQUALITY(0, (uintptr_t)plain % 64);
+    TEST_UINT_EQUALITY(0, (uintptr_t)encoded % 64);
+    TEST_UINT_EQUALITY(0, (uintptr_t)decoded % 64);
+    memset(plain, 0xC3, plain_size);
+    base57_encode(encoded, plain, plain_size);
+    TEST_UINT_EQUALITY(0, encoded[encoded_size]);
+    uint8_t* output = decoded;
+    const char* input = encoded;
+    base57_decode(&output, &input, &encoded_size);
+    TEST_UINT_EQUALITY(0, encoded_size);
+    TEST_UINT_EQUALITY(plain_size, output - decoded);
+    TEST_UINT_EQUALITY(0, memcmp(plain, decoded, plain_size));
+    base57_free(decoded);
+    base57_free(encoded);
+    base57_free(plain);
+}
+
+
+static void test_range_reencoding(size_t plain_size, size_t tests, uint64_t* lcg_state) {
+    uint8_t* plain = (uint8_t*)malloc(plain_size + 1);
+    char* encoded = (char*)malloc(base57_calculate_encoded_length(plain_size) + 1);
+    char* freshly_encoded = (char*)malloc(base57_calculate_encoded_length(plain_size) + 1);
+    const size_t encoded_size = base57_calculate_encoded_length(plain_size);
+    fill_randomly(plain, plain_size, lcg_state);
+    base57_encode(encoded, plain, plain_size);
+    base57_Range ranges[3];
+    for (size_t test = 0; test < tests; ++test) {
+        for (int r = 0; r < 3; ++r) {
+            ranges[r].offset = lcg(lcg_state) % (plain_size + 1);
+            ranges[r].length = lcg(lcg_state) % (plain_size - ranges[r].offset + 1) % 100;
+            fill_randomly(plain + ranges[r].offset, ranges[r].length, lcg_state);
+        }
+        if (test % 2 == 0) {
+            for (int r = 0; r < 3; ++r) {
+                TEST(base57_reencode_range(
+                    encoded, encoded_size, plain, plain_size, ranges[r].offset, ranges[r].length
+                ));
+            }
+        } else {
+            TEST(base57_reencode_ranges(encoded, encoded_size, plain, plain_size, ranges, 3));
+        }
+        base57_encode(freshly_encoded, plain, plain_size);
+        TEST_UINT_EQUALITY(0, memcmp(freshly_encoded, encoded, encoded_size));
+    }
+    TEST(!base57_reencode_range(encoded, encoded_size + 1, plain, plain_size, 0, 1));
+    TEST(!base57_reencode_range(encoded, encoded_size, plain, plain_size, plain_size, 1));
+    TEST(!base57_reencode_range(encoded, encoded_size, plain, plain_size, 1, plain_size));
+    ranges[1].offset = plain_size + 1;
+    TEST(!base57_reencode_ranges(encoded, encoded_size, plain, plain_size, ranges, 3));
+    free(freshly_encoded);
+    free(encoded);
+    free(plain);
+}
+
+
+#define MULTI_STREAMS 37
+
+
+static void test_multi_streams(size_t max_plain_size, uint64_t* lcg_state) {
+    uint8_t* plains[MULTI_STREAMS];
+    size_t plain_sizes[MULTI_STREAMS];
+    char* encodings[MULTI_STREAMS];
+    size_t encoded_sizes[MULTI_STREAMS];
+    uint8_t* decodings[MULTI_STREAMS];
+    base57_EncodingSegment encoding_segments[MULTI_STREAMS];
+    base57_DecodingSegment decoding_segments[MULTI_STREAMS];
+    char* encoding_outputs[MULTI_STREAMS];
+    uint8_t* decoding_outputs[MULTI_STREAMS];
+    size_t positions[MULTI_STREAMS];
+    base57_MultiEncoder* encoder = base57_create_multi_encoder(MULTI_STREAMS);
+    base57_MultiDecoder* decoder = base57_create_multi_decoder(MULTI_STREAMS);
+    TEST(encoder != NULL);
+    TEST(decoder != NULL);
+    for (size_t s = 0; s < MULTI_STREAMS; ++s) {
+        plain_sizes[s] = lcg(lcg_state) % (max_plain_size + 1);
+        plains[s] = (uint8_t*)malloc(plain_sizes[s] + 1);
+        fill_randomly(plains[s], plain_sizes[s], lcg_state);
+        encodings[s] = (char*)malloc(base57_calculate_encoded_part_max_length(plain_sizes[s]) + 12);
+        encoding_outputs[s] = encodings[s];
+        positions[s] = 0;
+    }
+    for (bool pending = true; pending; ) {
+        pending = false;
+        size_t segments_number = 0;
+        for (size_t s = 0; s < MULTI_STREAMS; ++s) {
+            if (positions[s] < plain_sizes[s] && lcg(lcg_state) % 4 != 0) {
+                base57_EncodingSegment* segment = &encoding_segments[segments_number++];
+                segment->output = encoding_outputs[s];
+                segment->stream = s;
+                segment->input = plains[s] + positions[s];
+                segment->input_length = lcg(lcg_state) % 100;
+                if (segment->input_length > plain_sizes[s] - positions[s]) {
+                    segment->input_length = plain_sizes[s] - positions[s];
+                }
+                positions[s] += segment->input_length;
+            }
+            pending |= positions[s] < plain_sizes[s];
+        }
+        base57_multi_encode_part(encoder, encoding_segments, segments_number);
+        for (size_t i = 0; i < segments_number; ++i) {
+            TEST_UINT_EQUALITY(0, encoding_segments[i].input_length);
+            encoding_outputs[encoding_segments[i].stream] = encoding_segments[i].output;
+        }
+    }
+    for (size_t s = 0; s < MULTI_STREAMS; ++s) {
+        char* output = encoding_outputs[s];
+        base57_multi_finish_encoding(encoder, s, &output);
+        encoded_sizes[s] = output - encodings[s];
+        char* single = (char*)malloc(base57_calculate_encoded_length(plain_sizes[s]) + 1);
+        base57_encode(single, plains[s], plain_sizes[s]);
+        TEST_UINT_EQUALITY(strlen(single), encoded_sizes[s]);
+        TEST_UINT_EQUALITY(0, memcmp(single, encodings[s], encoded_sizes[s]));
+        free(single);
+        decodings[s] = (uint8_t*)malloc(base57_calculate_decoded_max_length(encoded_sizes[s]) + 8);
+        decoding_outputs[s] = decodings[s];
+        positions[s] = 0;
+    }
+    for (bool pending = true; pending; ) {
+        pending = false;
+        size_t segments_number = 0;
+        for (size_t s = 0; s < MULTI_STREAMS; ++s) {
+            if (positions[s] < encoded_sizes[s] && lcg(lcg_state) % 4 != 0) {
+                base57_DecodingSegment* segment = &decoding_segments[segments_number++];
+                segment->output = decoding_outputs[s];
+                segment->stream = s;
+                segment->input = encodings[s] + positions[s];
+                segment->input_length = lcg(lcg_state) % 150;
+                if (segment->input_length > encoded_sizes[s] - positions[s]) {
+                    segment->input_length = encoded_sizes[s] - positions[s];
+                }
+                positions[s] += segment->input_length;
+            }
+            pending |= positions[s] < encoded_sizes[s];
+        }
+        base57_multi_decode_part(decoder, decoding_segments, segments_number);
+        for (size_t i = 0; i < segments_number; ++i) {
+            TEST_UINT_EQUALITY(0, decoding_segments[i].input_length);
+            decoding_outputs[decoding_segments[i].stream] = decoding_segments[i].output;
+        }
+    }
+    for (size_t s = 0; s < MULTI_STREAMS; ++s) {
+        uint8_t* output = decoding_outputs[s];
+        base57_multi_flush_decoding(decoder, s, &output);
+        TEST_UINT_EQUALITY(plain_sizes[s], output - decodings[s]);
+        TEST_UINT_EQUALITY(0, memcmp(plains[s], decodings[s], plain_sizes[s]));
+        free(decodings[s]);
+        free(encodings[s]);
+        free(plains[s]);
+    }
+    const char invalid[] = "Hello world, Hello\nworld!0";
+    base57_DecodingSegment segment = { 1, invalid, sizeof(invalid) - 1, NULL };
+    uint8_t multi_output[16];
+    segment.output = multi_output;
+    base57_multi_decode_part(decoder, &segment, 1);
+    uint8_t single_output[16];
+    uint8_t* single_end = single_output;
+    const char* single_input = invalid;
+    size_t single_length = sizeof(invalid) - 1;
+    base57_DecodingBuffer buffer = { 0 };
+    base57_decode_part(&single_end, &buffer, &single_input, &single_length);
+    TEST_UINT_EQUALITY(single_length, segment.input_length);
+    TEST(single_input == segment.input);
+    TEST_UINT_EQUALITY(single_end - single_output, segment.output - multi_output);
+    TEST_UINT_EQUALITY(0, memcmp(single_output, multi_output, single_end - single_output));
+    base57_destroy_multi_decoder(decoder);
+    base57_destroy_multi_encoder(encoder);
+}
+
+
+static void test_bounded_streaming(size_t plain_size, size_t max_capacity, uint64_t* lcg_state) {
+    uint8_t* plain = (uint8_t*)malloc(plain_size + 1);
+    const size_t encoded_size = base57_calculate_encoded_length(plain_size);
+    char* encoded = (char*)malloc(encoded_size + 1);
+    char* window = (char*)malloc(max_capacity + 1);
+    uint8_t* decoded = (uint8_t*)malloc(plain_size + 1);
+    fill_randomly(plain, plain_size, lcg_state);
+
+    base57_EncodingBuffer encoding_buffer = { 0 };
+    const uint8_t* input = plain;
+    size_t written = 0;
+    bool finished = false;
+    while (!finished) {
+        size_t input_length = lcg(lcg_state) % 300;
+        if (input_length > plain_size - (input - plain)) {
+            input_length = plain_size - (input - plain);
+        }
+        const uint8_t* const input_end = input + input_length;
+        size_t capacity = lcg(lcg_state) % (max_capacity + 1);
+        const size_t initial_capacity = capacity;
+        window[initial_capacity] = '#';
+        char* output = window;
+        base57_encode_part_bounded(&output, &capacity, &encoding_buffer, &input, &input_length);
+        TEST(input + input_length == input_end);
+        if (input == plain + plain_size) {
+            finished = base57_finish_encoding_bounded(&output, &capacity, &encoding_buffer);
+        }
+        TEST_UINT_EQUALITY(initial_capacity - capacity, output - window);
+        TEST_UINT_EQUALITY('#', window[initial_capacity]);
+        TEST_UINT_RELATION(encoded_size, >=, written + (output - window));
+        memcpy(encoded + written, window, output - window);
+        written += output - window;
+    }
+    char* expected_encoding = (char*)malloc(encoded_size + 1);
+    base57_encode(expected_encoding, plain, plain_size);
+    TEST_UINT_EQUALITY(encoded_size, written);
+    TEST_UINT_EQUALITY(0, memcmp(expected_encoding, encoded, encoded_size));
+    free(expected_encoding);
+
+    base57_DecodingBuffer decoding_buffer = { 0 };
+    const char* encoded_input = encoded;
+    uint8_t* decoded_output = decoded;
+    finished = false;
+    while (!finished) {
+        size_t input_length = lcg(lcg_state) % 300;
+        if (input_length > encoded_size - (encoded_input - encoded)) {
+            input_length = encoded_size - (encoded_input - encoded);
+        }
+        size_t capacity = lcg(lcg_state) % (max_capacity + 1);
+        if (capacity > plain_size - (decoded_output - decoded)) {
+            capacity = plain_size - (decoded_output - decoded);
+        }
+        TEST(base57_decode_part_bounded(&decoded_output, &capacity, &decoding_buffer, &encoded_input, &input_length));
+        if (encoded_input == encoded + encoded_size) {
+            finished = base57_flush_decoding_buffer_bounded(&decoded_output, &capacity, &decoding_buffer);
+        }
+    }
+    TEST_UINT_EQUALITY(plain_size, decoded_output - decoded);
+    TEST_UINT_EQUALITY(0, memcmp(plain, decoded, plain_size));
+
+    if (plain_size >= 3 * 64) { // a line after the first one does not fit into 88 bytes with its '\n'
+        base57_EncodingBuffer lines_buffer = { 0 };
+        char lines_window[2 * 89];
+        const uint8_t* lines_input = plain;
+        size_t lines_input_length = 3 * 64;
+        size_t lines_capacity = 88 + 88;
+        char* output = lines_window;
+        lines_window[lines_capacity] = '#';
+        base57_encode_part_bounded(&output, &lines_capacity, &lines_buffer, &lines_input, &lines_input_length);
+        TEST_UINT_EQUALITY(88 + 88 - lines_capacity, output - lines_window);
+        TEST_UINT_EQUALITY('#', lines_window[88 + 88]);
+        TEST_UINT_EQUALITY(0, memcmp(encoded, lines_window, output - lines_window));
+    }
+
+    const char* invalid = "Happy words!";
+    size_t invalid_length = strlen(invalid);
+    size_t capacity = 8;
+    decoded_output = decoded;
+    TEST(!base57_decode_part_bounded(&decoded_output, &capacity, &decoding_buffer, &invalid, &invalid_length));
+    TEST_UINT_EQUALITY('!', *invalid);
+
+    free(decoded);
+    free(window);
+    free(encoded);
+    free(plain);
+}
+
+
+static const char TEST_DELIMITERS[] = " \t\r\n\v\f,.-_:;'`+\\/\x1C\x1D\x1E\x1F";
+
+
+/// Copies symbols with randomly inserted delimiters.
+static size_t rewrap_randomly(char* output, const char* symbols, size_t symbols_length, uint64_t* lcg_state) {
+    char* const initial_output = output;
+    for (size_t i = 0; i < symbols_length; ++i) {
+        if (symbols[i] == '\n') {
+            continue;
+        }
+        while (lcg(lcg_state) % 8 == 0) {
+            *(output++) = TEST_DELIMITERS[lcg(lcg_state) % (sizeof(TEST_DELIMITERS) - 1)];
+        }
+        *(output++) = symbols[i];
+    }
+    return output - initial_output;
+}
+
+
+/// Normalizes in random parts and compares with a decoding and encoding round trip.
+static void test_normalization_of(const char* input, size_t input_length, uint64_t* lcg_state) {
+    char* normalized = (char*)malloc(base57_calculate_normalized_max_length(input_length));
+    char* output = normalized;
+    base57_NormalizingBuffer buffer = { 0 };
+    const char* remaining_input = input;
+    size_t remaining_length = input_length;
+    while (remaining_length > 0) {
+        size_t part_length = lcg(lcg_state) % 200;
+        if (part_length > remaining_length) {
+            part_length = remaining_length;
+        }
+        remaining_length -= part_length;
+        base57_normalize_part(&output, &buffer, &remaining_input, &part_length);
+        TEST_UINT_EQUALITY(0, part_length);
+    }
+    base57_flush_normalizing_buffer(&output, &buffer);
+
+    uint8_t* decoded = (uint8_t*)malloc(base57_calculate_decoded_max_length(input_length) + 1);
+    uint8_t* decoded_end = decoded;
+    const char* decoded_input = input;
+    size_t decoded_input_length = input_length;
+    base57_decode(&decoded_end, &decoded_input, &decoded_input_length);
+    TEST_UINT_EQUALITY(0, decoded_input_length);
+    const size_t decoded_length = decoded_end - decoded;
+    char* round_trip = (char*)malloc(base57_calculate_encoded_length(decoded_length) + 1);
+    base57_encode(round_trip, decoded, decoded_length);
+    TEST_UINT_EQUALITY(strlen(round_trip), output - normalized);
+    TEST_UINT_EQUALITY(0, memcmp(round_trip, normalized, output - normalized));
+    free(round_trip);
+    free(decoded);
+    free(normalized);
+}
+
+
+static void test_normalization(size_t plain_size, uint64_t* lcg_state) {
+    uint8_t* plain = (uint8_t*)malloc(plain_size + 1);
+    fill_randomly(plain, plain_size, lcg_state);
+    const size_t encoded_size = base57_calculate_encoded_length(plain_size);
+    char* encoded = (char*)malloc(encoded_size + 1);
+    base57_encode(encoded, plain, plain_size);
+    char* rewrapped = (char*)malloc(3 * encoded_size + 1);
+    test_normalization_of(encoded, encoded_size, lcg_state);
+    test_normalization_of(rewrapped, rewrap_randomly(rewrapped, encoded, encoded_size, lcg_state), lcg_state);
+
+    // words which are not encodings of any value, whole only because of asserts in decoding
+    const size_t symbols_length = encoded_size / base57_ENCODED_UINT64_SIZE * base57_ENCODED_UINT64_SIZE;
+    for (size_t i = 0; i < symbols_length; ++i) {
+        encoded[i] = "23456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz"[lcg(lcg_state) % 57];
+    }
+    test_normalization_of(rewrapped, rewrap_randomly(rewrapped, encoded, symbols_length, lcg_state), lcg_state);
+
+    if (symbols_length > 0) {
+        encoded[lcg(lcg_state) % symbols_length] = '!';
+        char* normalized = (char*)malloc(base57_calculate_normalized_max_length(symbols_length));
+        char* output = normalized;
+        const char* input = encoded;
+        size_t input_length = symbols_length;
+        base57_normalize(&output, &input, &input_length);
+        TEST_UINT_EQUALITY('!', *input);
+        TEST_UINT_EQUALITY(symbols_length - (input - encoded), input_length);
+
+        const char* stopping = "23456789ABC\r\n!DEFGHJKLMNPQRSTUV"; // in a block after delimiters
+        input = stopping;
+        input_length = strlen(stopping);
+        output = normalized;
+        base57_normalize(&output, &input, &input_length);
+        TEST_UINT_EQUALITY(13, input - stopping);
+        free(normalized);
+    }
+    free(rewrapped);
+    free(encoded);
+    free(plain);
+}
+
+
 #define PRINT_AND_CALL(STATEMENT) do { \
     fputs("\n" #STATEMENT "\n", output_stream); \
     do { STATEMENT; } while (false); \
@@ -307,6 +677,22 @@ int main() {
     uint64_t lcg_state = 0xC089D80887303354ull;
     PRINT_AND_CALL(test_random_bytes_encoding(8 * 1024, 1024, &lcg_state));
     PRINT_AND_CALL(test_random_bytes_encoding(1024 * 1024, 256, &lcg_state));
+    PRINT_AND_CALL(test_streaming_encoding(&lcg_state));
+    PRINT_AND_CALL(test_range_reencoding(1, 16, &lcg_state));
+    PRINT_AND_CALL(test_range_reencoding(1000, 256, &lcg_state));
+    PRINT_AND_CALL(test_range_reencoding(64 * 1024 + 5, 256, &lcg_state));
+    PRINT_AND_CALL(test_multi_streams(20, &lcg_state));
+    PRINT_AND_CALL(test_multi_streams(5000, &lcg_state));
+    PRINT_AND_CALL(test_bounded_streaming(0, 16, &lcg_state));
+    PRINT_AND_CALL(test_bounded_streaming(1000, 16, &lcg_state));
+    PRINT_AND_CALL(test_bounded_streaming(100 * 1000 + 3, 1000, &lcg_state));
+    for (size_t plain_size = 0; plain_size <= 80; ++plain_size) {
+        test_normalization(plain_size, &lcg_state);
+    }
+    PRINT_AND_CALL(test_normalization(64 * 1024 + 7, &lcg_state));
+    PRINT_AND_CALL(test_large_buffers_allocation(0));
+    PRINT_AND_CALL(test_large_buffers_allocation(1000));
+    PRINT_AND_CALL(test_large_buffers_allocation(24 * 1024 * 1024 + 5));
     char output[16];
     printf("%s\n", base57_encode_uint64(output, 0xbf13433c9e01b63bull));
     printf("%s\n", base57_encode_uint64(output, 0xd77eddbddabc4762ull));
@@ -0,0 +1,133 @@
+package tech.surdacki.base57.benchmarks;
+
+import org.openjdk.jmh.annotations.*;
+import org.openjdk.jmh.infra.Blackhole;
+import tech.surdacki.base57.Constants;
+import tech.surdacki.base57.Decoder;
+import tech.surdacki.base57.Encoder;
+
+import java.io.ByteArrayInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+
+/**
+ * Throughput of the bulk paths.
+ * The {@code bytes} secondary result is a plain payload throughput in bytes per second.
+ * Run with {@code -prof gc} to see an allocation rate.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class Base57Benchmarks {
+
+    static final int LONGS = 1024;
+
+    @Param({"64", "4096", "1048576"})
+    int plainSize;
+
+    byte[] plain;
+    byte[] encoded;
+    byte[] encodedBuffer;
+    byte[] decodedBuffer;
+    long[] longs;
+    long[] decodedLongs;
+    byte[] encodedLongs;
+
+    @AuxCounters(AuxCounters.Type.OPERATIONS)
+    @State(Scope.Thread)
+    public static class Payload {
+        public long bytes;
+
+        @Setup(Level.Iteration)
+        public void reset() {
+            bytes = 0;
+        }
+    }
+
+    @Setup
+    public void setUp() {
+        Random prng = new Random(0x3D7A61E0C94B285FL);
+        plain = new byte[plainSize];
+        prng.nextBytes(plain);
+        encoded = Encoder.encode(ByteBuffer.wrap(plain));
+        encodedBuffer = new byte[encoded.length];
+        decodedBuffer = new byte[plainSize];
+        longs = new long[LONGS];
+        for (int i = 0; i < LONGS; ++i) {
+            longs[i] = prng.nextLong();
+        }
+        decodedLongs = new long[LONGS];
+        encodedLongs = new byte[LONGS * Constants.ENCODED_LONG_LENGTH];
+        Encoder.encode(longs, 0, LONGS, encodedLongs, 0);
+    }
+
+    @Benchmark
+    public byte[] encodeBytes(Payload payload) {
+        Encoder.encode(plain, 0, plain.length, encodedBuffer, 0);
+        payload.bytes += plain.length;
+        return encodedBuffer;
+    }
+
+    @Benchmark
+    public byte[] decodeBytes(Payload payload) {
+        Decoder.decode(encoded, 0, encoded.length, decodedBuffer, 0);
+        payload.bytes += plain.length;
+        return decodedBuffer;
+    }
+
+    @Benchmark
+    public ByteBuffer encodeHeapBuffer(Payload payload) {
+        ByteBuffer dst = ByteBuffer.wrap(encodedBuffer);
+        Encoder.encode(ByteBuffer.wrap(plain), dst);
+        payload.bytes += plain.length;
+        return dst;
+    }
+
+    @Benchmark
+    public ByteBuffer decodeHeapBuffer(Payload payload) {
+        ByteBuffer dst = ByteBuffer.wrap(decodedBuffer);
+        Decoder.decode(ByteBuffer.wrap(encoded), dst);
+        payload.bytes += plain.length;
+        return dst;
+    }
+
+    @Benchmark
+    public byte[] decodeStream(Payload payload) throws IOException {
+        InputStream ds = Decoder.wrap(new ByteArrayInputStream(encoded));
+        int position = 0;
+        while (position < decodedBuffer.length) {
+            position += ds.read(decodedBuffer, position, decodedBuffer.length - position);
+        }
+        payload.bytes += plain.length;
+        return decodedBuffer;
+    }
+
+    @Benchmark
+    public byte[] encodeLongs(Payload payload) {
+        Encoder.encode(longs, 0, LONGS, encodedLongs, 0);
+        payload.bytes += LONGS * Long.BYTES;
+        return encodedLongs;
+    }
+
+    @Benchmark
+    public void encodeLongsAllocating(Payload payload, Blackhole blackhole) {
+        for (long n : longs) {
+            blackhole.consume(Encoder.encode(n));
+        }
+        payload.bytes += LONGS * Long.BYTES;
+    }
+
+    @Benchmark
+    public long[] decodeLongs(Payload payload) {
+        Decoder.decode(encodedLongs, 0, decodedLongs, 0, LONGS);
+        payload.bytes += LONGS * Long.BYTES;
+        return decodedLongs;
+    }
+}
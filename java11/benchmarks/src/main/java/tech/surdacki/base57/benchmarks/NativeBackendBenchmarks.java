@@ -0,0 +1,79 @@
+package tech.surdacki.base57.benchmarks;
+
+import org.openjdk.jmh.annotations.*;
+import tech.surdacki.base57.Decoder;
+import tech.surdacki.base57.Encoder;
+
+import java.nio.ByteBuffer;
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+
+/**
+ * Pure Java versus the base57jni library over direct buffers by payload size.
+ * Requires {@code -Djava.library.path} pointing to the base57jni library.
+ * The payload size where the native results overtake the Java ones is
+ * a good value for {@code -Dtech.surdacki.base57.nativeThreshold}.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@State(Scope.Thread)
+public class NativeBackendBenchmarks {
+
+    @Param({"8", "64", "256", "1024", "4096", "65536", "1048576"})
+    int plainSize;
+
+    ByteBuffer plain;
+    ByteBuffer encoded;
+    ByteBuffer encodedBuffer;
+    ByteBuffer decodedBuffer;
+
+    @Setup
+    public void setUp() {
+        byte[] bytes = new byte[plainSize];
+        new Random(0x71C2E5A0B83F4D96L).nextBytes(bytes);
+        plain = ByteBuffer.allocateDirect(plainSize).put(bytes).flip();
+        byte[] encodedBytes = Encoder.encode(ByteBuffer.wrap(bytes));
+        encoded = ByteBuffer.allocateDirect(encodedBytes.length).put(encodedBytes).flip();
+        encodedBuffer = ByteBuffer.allocateDirect(encodedBytes.length);
+        decodedBuffer = ByteBuffer.allocateDirect(Decoder.calcDecodedMaxLength(encodedBytes.length));
+    }
+
+    @Benchmark
+    @Fork(value = 1, jvmArgsAppend = "-Dtech.surdacki.base57.native=false")
+    public ByteBuffer encodeJava() {
+        return encode();
+    }
+
+    @Benchmark
+    @Fork(value = 1, jvmArgsAppend = "-Dtech.surdacki.base57.nativeThreshold=0")
+    public ByteBuffer encodeNative() {
+        return encode();
+    }
+
+    @Benchmark
+    @Fork(value = 1, jvmArgsAppend = "-Dtech.surdacki.base57.native=false")
+    public ByteBuffer decodeJava() {
+        return decode();
+    }
+
+    @Benchmark
+    @Fork(value = 1, jvmArgsAppend = "-Dtech.surdacki.base57.nativeThreshold=0")
+    public ByteBuffer decodeNative() {
+        return decode();
+    }
+
+    ByteBuffer encode() {
+        encodedBuffer.clear();
+        Encoder.encode(plain.duplicate(), encodedBuffer);
+        return encodedBuffer;
+    }
+
+    ByteBuffer decode() {
+        decodedBuffer.clear();
+        Decoder.decode(encoded.duplicate(), decodedBuffer);
+        return decodedBuffer;
+    }
+}
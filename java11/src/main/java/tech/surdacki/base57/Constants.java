@@ -1,5 +1,8 @@
 package tech.surdacki.base57;
 
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteOrder;
 import java.nio.charset.StandardCharsets;
 
 
@@ -9,6 +12,10 @@ public final class Constants {
     public static final int ENCODED_LINE_LENGTH
             = ENCODED_LONGS_PER_LINE * ENCODED_LONG_LENGTH + 1;
     public static final int DECODED_LINE_LENGTH = ENCODED_LONGS_PER_LINE * Long.BYTES;
+    /** Positions of 56 radix symbols (r) in the ArArArrArAr pattern. */
+    static final int SHIFTED_POSITIONS = 0b10101101010;
+    static final VarHandle LITTLE_ENDIAN_LONG
+            = MethodHandles.byteArrayViewVarHandle(long[].class, ByteOrder.LITTLE_ENDIAN);
     static final byte[] PLAIN_TO_ENCODED_LENGTH_MAPPING = {
         //  0, 1, 2, 3, 4, 5, 6,  7,  8
             0, 2, 3, 5, 6, 7, 9, 10, 11
@@ -2,10 +2,17 @@ package tech.surdacki.base57;
 
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.BufferOverflowException;
+import java.nio.BufferUnderflowException;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.channels.ReadableByteChannel;
+import java.nio.channels.WritableByteChannel;
 import java.nio.charset.StandardCharsets;
-import java.util.Arrays;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
 import java.util.Objects;
 import java.util.UUID;
 
@@ -14,6 +21,14 @@ import static tech.surdacki.base57.Constants.*;
 
 public final class Decoder {
     public static long decodeLong(ByteBuffer src) {
+        if (src.hasArray()) {
+            int position = src.position();
+            if (src.limit() - position < ENCODED_LONG_LENGTH) {
+                throw new BufferUnderflowException();
+            }
+            src.position(position + ENCODED_LONG_LENGTH);
+            return decodeLong(src.array(), src.arrayOffset() + position);
+        }
         byte symbolValue;
         int shiftedValue;
         long result = 0;
@@ -72,6 +87,66 @@ public final class Decoder {
         return result;
     }
 
+    public static long decodeLong(byte[] src, int off) {
+        Objects.checkFromIndexSize(off, ENCODED_LONG_LENGTH, src.length);
+        byte symbolValue;
+        int shiftedValue;
+        long result = 0;
+        int shift = 0;
+
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[0];
+
+        shift += shiftedValue + 1;
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 1])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[1];
+
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 2])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[2];
+
+        shift += shiftedValue + 1;
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 3])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[3];
+
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 4])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[4];
+
+        shift += shiftedValue + 1;
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 5])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[5];
+
+        shift += shiftedValue + 1;
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 6])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[6];
+
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 7])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[7];
+
+        shift += shiftedValue + 1;
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 8])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[8];
+
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 9])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[9];
+
+        shift += shiftedValue + 1;
+        symbolValue = SYMBOL_VALUES[Byte.toUnsignedInt(src[off + 10])];
+        shiftedValue = (570 + symbolValue - shift) % 57;
+        result += shiftedValue * MAGNITUDES[10];
+
+        return result;
+    }
+
     public static long decodeLong(String src) {
         byte[] bytes = src.getBytes(StandardCharsets.US_ASCII);
         return decodeLong(ByteBuffer.wrap(bytes));
@@ -83,36 +158,188 @@ public final class Decoder {
         return new UUID(hi, lo);
     }
 
+    public static UUID decodeUuid(byte[] src, int off) {
+        long lo = decodeLong(src, off);
+        long hi = decodeLong(src, off + ENCODED_LONG_LENGTH);
+        return new UUID(hi, lo);
+    }
+
     public static UUID decodeUuid(String src) {
         byte[] bytes = src.getBytes(StandardCharsets.US_ASCII);
         return decodeUuid(ByteBuffer.wrap(bytes));
     }
 
+    /**
+     * Decodes {@code count} consecutive 11 symbols long words without delimiters.
+     */
+    public static void decode(byte[] src, int srcOff, long[] dst, int dstOff, int count) {
+        Objects.checkFromIndexSize(srcOff, Math.multiplyExact(count, ENCODED_LONG_LENGTH), src.length);
+        Objects.checkFromIndexSize(dstOff, count, dst.length);
+        for (int i = 0; i < count; ++i) {
+            dst[dstOff + i] = decodeLong(src, srcOff + i * ENCODED_LONG_LENGTH);
+        }
+    }
+
+    /**
+     * Decodes {@code count} consecutive 22 symbols long words without delimiters.
+     */
+    public static void decode(byte[] src, int srcOff, UUID[] dst, int dstOff, int count) {
+        Objects.checkFromIndexSize(srcOff, Math.multiplyExact(count, 2 * ENCODED_LONG_LENGTH), src.length);
+        Objects.checkFromIndexSize(dstOff, count, dst.length);
+        for (int i = 0; i < count; ++i) {
+            dst[dstOff + i] = decodeUuid(src, srcOff + i * 2 * ENCODED_LONG_LENGTH);
+        }
+    }
+
     public static int calcDecodedMaxLength(int encodedLength) {
         int longs = encodedLength / ENCODED_LONG_LENGTH;
         int remain = encodedLength %  ENCODED_LONG_LENGTH;
         return longs * Long.BYTES + ENCODED_TO_PLAIN_LENGTH_MAPPING[remain];
     }
 
+    /**
+     * Decodes {@code src[srcOff, srcOff + srcLen)} into {@code dst} starting at {@code dstOff}.
+     * Whole words are decoded straight from the array, delimiters are skipped.
+     * @return number of written bytes
+     * @throws IllegalArgumentException on a non Base57 symbol
+     * @throws IndexOutOfBoundsException if decoded data do not fit into {@code dst}
+     */
+    public static int decode(byte[] src, int srcOff, int srcLen, byte[] dst, int dstOff) {
+        Objects.checkFromIndexSize(srcOff, srcLen, src.length);
+        Objects.checkFromToIndex(dstOff, dst.length, dst.length);
+        try {
+            return decodeArraysOrNative(src, srcOff, srcLen, dst, dstOff, dst.length);
+        } catch (BufferOverflowException e) {
+            throw new IndexOutOfBoundsException("Decoded data do not fit into dst.");
+        }
+    }
+
+    static int decodeArraysOrNative(byte[] src, int srcOff, int srcLen, byte[] dst, int dstOff, int dstEnd) {
+        if (NativeBackend.accepts(srcLen)) {
+            int written = NativeBackend.decodeArray(src, srcOff, srcLen, dst, dstOff, dstEnd - dstOff);
+            if (written >= 0) {
+                return written;
+            }
+        }
+        return decodeArrays(src, srcOff, srcLen, dst, dstOff, dstEnd);
+    }
+
+    /**
+     * Decodes into {@code dst[dstOff, dstEnd)}, a room is checked per word,
+     * so a destination may have exactly the decoded length.
+     * @throws BufferOverflowException if decoded data do not fit
+     */
+    static int decodeArrays(byte[] src, int srcOff, int srcLen, byte[] dst, int dstOff, int dstEnd) {
+        int i = srcOff;
+        int end = srcOff + srcLen;
+        int o = dstOff;
+        int symbols = 0;
+        int shift = 0;
+        int shiftedValue = 0;
+        long result = 0;
+        while (i < end) {
+            if (symbols == 0 && end - i >= ENCODED_LONG_LENGTH && isWord(src, i)) {
+                if (dstEnd - o < Long.BYTES) {
+                    throw new BufferOverflowException();
+                }
+                LITTLE_ENDIAN_LONG.set(dst, o, decodeLong(src, i));
+                i += ENCODED_LONG_LENGTH;
+                o += Long.BYTES;
+                continue;
+            }
+            byte symbol = src[i++];
+            byte symbolValue = SYMBOL_VALUES[0xFF & symbol];
+            if (symbolValue >= 57) {
+                checkDelimiter(symbol, symbolValue);
+                continue;
+            }
+            if ((SHIFTED_POSITIONS >>> symbols & 1) != 0) {
+                shift += shiftedValue + 1;
+            }
+            shiftedValue = (570 + symbolValue - shift) % 57;
+            result += shiftedValue * MAGNITUDES[symbols++];
+            if (symbols == ENCODED_LONG_LENGTH) {
+                if (dstEnd - o < Long.BYTES) {
+                    throw new BufferOverflowException();
+                }
+                LITTLE_ENDIAN_LONG.set(dst, o, result);
+                o += Long.BYTES;
+                symbols = 0;
+                shift = 0;
+                result = 0;
+            }
+        }
+        if (dstEnd - o < ENCODED_TO_PLAIN_LENGTH_MAPPING[symbols]) {
+            throw new BufferOverflowException();
+        }
+        result %= MAGNITUDES[symbols]; // as if padded, which only adds multiples of the magnitude
+        for (int dl = ENCODED_TO_PLAIN_LENGTH_MAPPING[symbols]; dl > 0; --dl) {
+            dst[o++] = (byte)result;
+            result >>>= 8;
+        }
+        return o - dstOff;
+    }
+
     public static void decode(ByteBuffer src, ByteBuffer dst) {
+        if (NativeBackend.accepts(src, dst)) {
+            int written = NativeBackend.decode(
+                    src, src.position(), src.remaining(), dst, dst.position(), dst.remaining()
+            );
+            if (written >= 0) {
+                src.position(src.limit());
+                dst.position(dst.position() + written);
+                return;
+            }
+        }
+        if (src.hasArray() && dst.hasArray()) {
+            int written = decodeArraysOrNative(
+                    src.array(), src.arrayOffset() + src.position(), src.remaining(),
+                    dst.array(), dst.arrayOffset() + dst.position(), dst.arrayOffset() + dst.limit()
+            );
+            src.position(src.limit());
+            dst.position(dst.position() + written);
+            return;
+        }
         dst.order(ByteOrder.LITTLE_ENDIAN);
-        ByteBuffer buffer = ByteBuffer.allocate(ENCODED_LONG_LENGTH);
+        int symbols = 0;
+        int shift = 0;
+        int shiftedValue = 0;
+        long result = 0;
         while (src.hasRemaining()) {
-            putSymbolOnly(src.get(), buffer);
-            if (!buffer.hasRemaining()) {
-                dst.putLong(decodeLong(buffer.flip()));
-                buffer.clear();
+            byte symbol = src.get();
+            byte symbolValue = SYMBOL_VALUES[0xFF & symbol];
+            if (symbolValue >= 57) {
+                checkDelimiter(symbol, symbolValue);
+                continue;
+            }
+            if ((SHIFTED_POSITIONS >>> symbols & 1) != 0) {
+                shift += shiftedValue + 1;
+            }
+            shiftedValue = (570 + symbolValue - shift) % 57;
+            result += shiftedValue * MAGNITUDES[symbols++];
+            if (symbols == ENCODED_LONG_LENGTH) {
+                dst.putLong(result);
+                symbols = 0;
+                shift = 0;
+                result = 0;
             }
         }
-        if (buffer.position() > 0) {
-            flushBuffer(buffer, dst);
+        result %= MAGNITUDES[symbols]; // as if padded, which only adds multiples of the magnitude
+        for (int dl = ENCODED_TO_PLAIN_LENGTH_MAPPING[symbols]; dl > 0; --dl) {
+            dst.put((byte)result);
+            result >>>= 8;
         }
     }
 
     public static byte[] decode(ByteBuffer src) {
-        ByteBuffer dst = ByteBuffer.allocate(calcDecodedMaxLength(src.remaining()));
-        decode(src, dst);
-        return Arrays.copyOfRange(dst.array(), 0, dst.position());
+        byte[] result = new byte[calcDecodedMaxLength(countSymbols(src))];
+        if (src.hasArray()) {
+            decode(src.array(), src.arrayOffset() + src.position(), src.remaining(), result, 0);
+            src.position(src.limit());
+        } else {
+            decode(src, ByteBuffer.wrap(result));
+        }
+        return result;
     }
 
     public static byte[] decode(String src) {
@@ -124,47 +351,255 @@ public final class Decoder {
         return new DecodingInputStream(is);
     }
 
-    static void putSymbolOnly(byte symbol, ByteBuffer buffer) {
-        byte symbol_value = SYMBOL_VALUES[0xFF & symbol];
-        if (symbol_value < 57) {
-            buffer.put(symbol);
-            return;
+    public static ReadableByteChannel wrap(ReadableByteChannel channel) {
+        return new DecodingChannel(channel);
+    }
+
+    /**
+     * Decodes everything from {@code src} into {@code dst}, neither of them is closed.
+     * @return number of decoded bytes written
+     */
+    public static long decode(ReadableByteChannel src, WritableByteChannel dst) throws IOException {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(DecodingChannel.BUFFER_SIZE);
+        long total = 0;
+        ReadableByteChannel decodingChannel = wrap(src);
+        while (decodingChannel.read(buffer) >= 0) {
+            total += buffer.position();
+            writeFully(buffer, dst);
         }
-        if (symbol_value != DELIMITER_VALUE) {
+        return total;
+    }
+
+    /**
+     * Decodes {@code src} file into {@code dst} file.
+     * The encoded file is memory mapped in chunks and decoded output is written in large batches.
+     */
+    public static void decodeFile(Path src, Path dst) throws IOException {
+        decodeFile(src, dst, MAPPED_CHUNK_SIZE);
+    }
+
+    /** Maps the encoded file in chunks of {@code mappedChunkSize} bytes. */
+    static void decodeFile(Path src, Path dst, long mappedChunkSize) throws IOException {
+        try (
+            FileChannel in = FileChannel.open(src, StandardOpenOption.READ);
+            FileChannel out = FileChannel.open(
+                    dst, StandardOpenOption.WRITE,
+                    StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING
+            )
+        ) {
+            DecodingState state = new DecodingState();
+            ByteBuffer decoded = ByteBuffer.allocateDirect(DecodingChannel.BUFFER_SIZE);
+            long encodedLength = in.size();
+            long encodedPosition = 0;
+            while (encodedPosition < encodedLength) {
+                long encodedChunk = Math.min(mappedChunkSize, encodedLength - encodedPosition);
+                MappedByteBuffer encoded = in.map(FileChannel.MapMode.READ_ONLY, encodedPosition, encodedChunk);
+                while (encoded.hasRemaining()) {
+                    state.decode(encoded, decoded);
+                    if (decoded.remaining() < Long.BYTES) {
+                        writeFully(decoded, out);
+                    }
+                }
+                encodedPosition += encodedChunk;
+            }
+            if (decoded.remaining() < Long.BYTES) {
+                writeFully(decoded, out);
+            }
+            state.flush(decoded);
+            writeFully(decoded, out);
+        }
+    }
+
+    static final long MAPPED_CHUNK_SIZE = 1L << 26;
+
+    static void writeFully(ByteBuffer buffer, WritableByteChannel channel) throws IOException {
+        buffer.flip();
+        while (buffer.hasRemaining()) {
+            channel.write(buffer);
+        }
+        buffer.clear();
+    }
+
+    static boolean isWord(byte[] src, int off) {
+        for (int i = off; i < off + ENCODED_LONG_LENGTH; ++i) {
+            if (SYMBOL_VALUES[0xFF & src[i]] >= 57) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static int countSymbols(ByteBuffer src) {
+        int symbols = 0;
+        for (int i = src.position(); i < src.limit(); ++i) {
+            if (SYMBOL_VALUES[0xFF & src.get(i)] < 57) {
+                symbols += 1;
+            }
+        }
+        return symbols;
+    }
+
+    static void checkDelimiter(byte symbol, byte symbolValue) {
+        if (symbolValue != DELIMITER_VALUE) {
             throw new IllegalArgumentException(String.format(
                     "Non Base57 symbol 0x%02X encountered.", symbol
             ));
         }
     }
 
-    static void flushBuffer(ByteBuffer buffer, ByteBuffer dst) {
-        int encoded_length = buffer.position();
-        padInputBuffer(buffer);
-        long decoded = decodeLong(buffer.flip()) % MAGNITUDES[encoded_length];
-        for (int dl = ENCODED_TO_PLAIN_LENGTH_MAPPING[encoded_length]; dl > 0; --dl) {
-            dst.put((byte)decoded);
-            decoded >>= 8;
+    /**
+     * Decoding state which is carried over between consecutive source buffers.
+     */
+    static final class DecodingState {
+        int symbols = 0;
+        int shift = 0;
+        int shiftedValue = 0;
+        long wordValue = 0;
+
+        /**
+         * Decodes {@code src} while {@code dst} has a room for a whole word.
+         */
+        void decode(ByteBuffer src, ByteBuffer dst) {
+            boolean littleEndian = dst.order() == ByteOrder.LITTLE_ENDIAN;
+            int i = src.position();
+            int end = src.limit();
+            int o = dst.position();
+            int dstEnd = dst.limit();
+            while (i < end && dstEnd - o >= Long.BYTES) {
+                byte symbol = src.get(i++);
+                byte symbolValue = SYMBOL_VALUES[0xFF & symbol];
+                if (symbolValue >= 57) {
+                    if (symbolValue != DELIMITER_VALUE) {
+                        src.position(i - 1);
+                        dst.position(o);
+                        checkDelimiter(symbol, symbolValue);
+                    }
+                    continue;
+                }
+                if ((SHIFTED_POSITIONS >>> symbols & 1) != 0) {
+                    shift += shiftedValue + 1;
+                }
+                shiftedValue = (570 + symbolValue - shift) % 57;
+                wordValue += shiftedValue * MAGNITUDES[symbols++];
+                if (symbols == ENCODED_LONG_LENGTH) {
+                    dst.putLong(o, littleEndian ? wordValue : Long.reverseBytes(wordValue));
+                    o += Long.BYTES;
+                    reset();
+                }
+            }
+            src.position(i);
+            dst.position(o);
+        }
+
+        /**
+         * Puts a last partial word.
+         * @param dst must have at least 7 bytes remaining
+         */
+        void flush(ByteBuffer dst) {
+            wordValue %= MAGNITUDES[symbols]; // as if padded, which only adds multiples of the magnitude
+            for (int dl = ENCODED_TO_PLAIN_LENGTH_MAPPING[symbols]; dl > 0; --dl) {
+                dst.put((byte)wordValue);
+                wordValue >>>= 8;
+            }
+            reset();
+        }
+
+        void reset() {
+            symbols = 0;
+            shift = 0;
+            shiftedValue = 0;
+            wordValue = 0;
         }
     }
 
-    static void padInputBuffer(ByteBuffer buffer) {
-        byte symbol_value = SYMBOL_VALUES[buffer.get(buffer.position() - 1)];
-        while (buffer.hasRemaining()) {
-            buffer.put(SYMBOLS[symbol_value += 1]);
+    /**
+     * Reads encoded data from a channel in large chunks and decodes them straight into a reader buffer.
+     */
+    public static final class DecodingChannel implements ReadableByteChannel {
+
+        static final int BUFFER_SIZE = 1 << 16;
+
+        final ReadableByteChannel channel;
+        final ByteBuffer readBuffer = ByteBuffer.allocateDirect(BUFFER_SIZE);
+        final ByteBuffer pending = ByteBuffer.allocate(Long.BYTES);
+        final DecodingState state = new DecodingState();
+        boolean endOfStream = false;
+
+        public DecodingChannel(ReadableByteChannel channel) {
+            this.channel = channel;
+            readBuffer.limit(0);
+            pending.order(ByteOrder.LITTLE_ENDIAN).limit(0);
+        }
+
+        @Override
+        public int read(ByteBuffer dst) throws IOException {
+            if (!dst.hasRemaining()) {
+                return 0;
+            }
+            int start = dst.position();
+            while (dst.hasRemaining()) {
+                if (pending.hasRemaining()) {
+                    while (pending.hasRemaining() && dst.hasRemaining()) {
+                        dst.put(pending.get());
+                    }
+                    continue;
+                }
+                if (!readBuffer.hasRemaining()) {
+                    if (endOfStream) {
+                        break;
+                    }
+                    readBuffer.clear();
+                    int read = channel.read(readBuffer);
+                    readBuffer.flip();
+                    if (read < 0) {
+                        endOfStream = true;
+                        pending.clear();
+                        state.flush(pending);
+                        pending.flip();
+                        continue;
+                    }
+                    if (read == 0) {
+                        break;
+                    }
+                }
+                if (dst.remaining() >= Long.BYTES) {
+                    state.decode(readBuffer, dst);
+                } else {
+                    pending.clear();
+                    state.decode(readBuffer, pending);
+                    pending.flip();
+                }
+            }
+            int read = dst.position() - start;
+            return read == 0 && endOfStream && !pending.hasRemaining() ? -1 : read;
+        }
+
+        @Override
+        public boolean isOpen() {
+            return channel.isOpen();
+        }
+
+        @Override
+        public void close() throws IOException {
+            channel.close();
         }
     }
 
     public static final class DecodingInputStream extends InputStream {
 
         final InputStream is;
-        final ByteBuffer readBuffer = ByteBuffer.allocate(0x8000);
-        final ByteBuffer decodingBuffer = ByteBuffer.allocate(ENCODED_LONG_LENGTH);
+        final byte[] readBuffer = new byte[0x8000];
+        int readPosition = 0;
+        int readLimit = 0;
+        int symbols = 0;
+        int shift = 0;
+        int shiftedValue = 0;
+        long wordValue = 0;
         long outputValue;
         int outputBytes = 0;
 
         public DecodingInputStream(InputStream is) {
             this.is = is;
-            readBuffer.position(readBuffer.limit());
         }
 
         @Override
@@ -193,6 +628,12 @@ public final class Decoder {
                         return i > off ? i - off : -1;
                     }
                 }
+                if (outputBytes == Long.BYTES && end - i >= Long.BYTES) {
+                    LITTLE_ENDIAN_LONG.set(b, i, outputValue);
+                    i += Long.BYTES;
+                    outputBytes = 0;
+                    continue;
+                }
                 b[i++] = (byte)outputValue;
                 outputValue >>>= 8;
                 outputBytes -= 1;
@@ -206,39 +647,55 @@ public final class Decoder {
         }
 
         void decode() throws IOException {
-            fillDecodingBuffer();
-            if (decodingBuffer.hasRemaining()) {
-                flushDecodingBuffer();
-            } else {
-                decodingBuffer.flip();
-                outputValue = decodeLong(decodingBuffer);
-                outputBytes = Long.BYTES;
-            }
-            decodingBuffer.clear();
-        }
-
-        void fillDecodingBuffer() throws IOException {
-            while (decodingBuffer.hasRemaining()) {
-                if (!readBuffer.hasRemaining()) {
-                    int read = is.read(readBuffer.array());
+            while (true) {
+                if (readPosition == readLimit) {
+                    int read = is.read(readBuffer);
                     if (read < 0) {
+                        flushDecodingState();
                         return;
                     }
-                    readBuffer.position(0);
-                    readBuffer.limit(read);
+                    readPosition = 0;
+                    readLimit = read;
+                    continue;
+                }
+                if (symbols == 0 && readLimit - readPosition >= ENCODED_LONG_LENGTH
+                        && isWord(readBuffer, readPosition)) {
+                    outputValue = decodeLong(readBuffer, readPosition);
+                    outputBytes = Long.BYTES;
+                    readPosition += ENCODED_LONG_LENGTH;
+                    return;
+                }
+                byte symbol = readBuffer[readPosition++];
+                byte symbolValue = SYMBOL_VALUES[0xFF & symbol];
+                if (symbolValue >= 57) {
+                    checkDelimiter(symbol, symbolValue);
+                    continue;
+                }
+                if ((SHIFTED_POSITIONS >>> symbols & 1) != 0) {
+                    shift += shiftedValue + 1;
+                }
+                shiftedValue = (570 + symbolValue - shift) % 57;
+                wordValue += shiftedValue * MAGNITUDES[symbols++];
+                if (symbols == ENCODED_LONG_LENGTH) {
+                    outputValue = wordValue;
+                    outputBytes = Long.BYTES;
+                    resetDecodingState();
+                    return;
                 }
-                putSymbolOnly(readBuffer.get(), decodingBuffer);
             }
         }
 
-        void flushDecodingBuffer() {
-            if (decodingBuffer.position() > 0) {
-                int encoded_length = decodingBuffer.position();
-                padInputBuffer(decodingBuffer);
-                decodingBuffer.flip();
-                outputValue = decodeLong(decodingBuffer) % MAGNITUDES[encoded_length];
-                outputBytes = ENCODED_TO_PLAIN_LENGTH_MAPPING[encoded_length];
-            }
+        void flushDecodingState() {
+            outputValue = wordValue % MAGNITUDES[symbols]; // as if padded
+            outputBytes = ENCODED_TO_PLAIN_LENGTH_MAPPING[symbols];
+            resetDecodingState();
+        }
+
+        void resetDecodingState() {
+            symbols = 0;
+            shift = 0;
+            shiftedValue = 0;
+            wordValue = 0;
         }
     }
 }
@@ -3,9 +3,18 @@ package tech.surdacki.base57;
 import java.io.FilterOutputStream;
 import java.io.IOException;
 import java.io.OutputStream;
+import java.nio.BufferOverflowException;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.FileChannel;
+import java.nio.channels.ReadableByteChannel;
+import java.nio.channels.WritableByteChannel;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Objects;
 import java.util.UUID;
 
 import static tech.surdacki.base57.Constants.*;
@@ -14,6 +23,15 @@ import static tech.surdacki.base57.Constants.*;
 public final class Encoder {
 
     public static void encode(long n, ByteBuffer dst) {
+        if (dst.hasArray()) {
+            int position = dst.position();
+            if (dst.limit() - position < ENCODED_LONG_LENGTH) {
+                throw new BufferOverflowException();
+            }
+            encode(n, dst.array(), dst.arrayOffset() + position);
+            dst.position(position + ENCODED_LONG_LENGTH);
+            return;
+        }
         int value;
         int shift = 0;
 
@@ -68,9 +86,65 @@ public final class Encoder {
         dst.put(SYMBOLS[shift + value]);
     }
 
+    public static void encode(long n, byte[] dst, int off) {
+        Objects.checkFromIndexSize(off, ENCODED_LONG_LENGTH, dst.length);
+        int value;
+        int shift = 0;
+
+        value = (int)Long.remainderUnsigned(n, 57);
+        n = Long.divideUnsigned(n, 57);
+        dst[off] = SYMBOLS[shift + value];
+
+        shift += value + 1;
+        value = (int)Long.remainderUnsigned(n, 56);
+        n = Long.divideUnsigned(n, 56);
+        dst[off + 1] = SYMBOLS[shift + value];
+
+        value = (int)Long.remainderUnsigned(n, 57);
+        n = Long.divideUnsigned(n, 57);
+        dst[off + 2] = SYMBOLS[shift + value];
+
+        shift += value + 1;
+        value = (int)Long.remainderUnsigned(n, 56);
+        n = Long.divideUnsigned(n, 56);
+        dst[off + 3] = SYMBOLS[shift + value];
+
+        value = (int)Long.remainderUnsigned(n, 57);
+        n = Long.divideUnsigned(n, 57);
+        dst[off + 4] = SYMBOLS[shift + value];
+
+        shift += value + 1;
+        value = (int)Long.remainderUnsigned(n, 56);
+        n = Long.divideUnsigned(n, 56);
+        dst[off + 5] = SYMBOLS[shift + value];
+
+        shift += value + 1;
+        value = (int)Long.remainderUnsigned(n, 56);
+        n = Long.divideUnsigned(n, 56);
+        dst[off + 6] = SYMBOLS[shift + value];
+
+        value = (int)Long.remainderUnsigned(n, 57);
+        n = Long.divideUnsigned(n, 57);
+        dst[off + 7] = SYMBOLS[shift + value];
+
+        shift += value + 1;
+        value = (int)Long.remainderUnsigned(n, 56);
+        n = Long.divideUnsigned(n, 56);
+        dst[off + 8] = SYMBOLS[shift + value];
+
+        value = (int)Long.remainderUnsigned(n, 57);
+        n = Long.divideUnsigned(n, 57);
+        dst[off + 9] = SYMBOLS[shift + value];
+
+        shift += value + 1;
+        assert n < 56;
+        value = (int)n;
+        dst[off + 10] = SYMBOLS[shift + value];
+    }
+
     public static byte[] encode(long n) {
         byte[] result = new byte[ENCODED_LONG_LENGTH];
-        encode(n, ByteBuffer.wrap(result));
+        encode(n, result, 0);
         return result;
     }
 
@@ -83,17 +157,48 @@ public final class Encoder {
         encode(uuid.getMostSignificantBits(), dst);
     }
 
+    public static void encode(UUID uuid, byte[] dst, int off) {
+        encode(uuid.getLeastSignificantBits(), dst, off);
+        encode(uuid.getMostSignificantBits(), dst, off + ENCODED_LONG_LENGTH);
+    }
+
     public static byte[] encode(UUID uuid) {
         byte[] result = new byte[2 * ENCODED_LONG_LENGTH];
-        encode(uuid, ByteBuffer.wrap(result));
+        encode(uuid, result, 0);
         return result;
     }
 
+    /**
+     * Encodes {@code count} longs as consecutive 11 symbols long words without delimiters.
+     */
+    public static void encode(long[] src, int srcOff, int count, byte[] dst, int dstOff) {
+        Objects.checkFromIndexSize(srcOff, count, src.length);
+        Objects.checkFromIndexSize(dstOff, Math.multiplyExact(count, ENCODED_LONG_LENGTH), dst.length);
+        for (int i = 0; i < count; ++i) {
+            encode(src[srcOff + i], dst, dstOff + i * ENCODED_LONG_LENGTH);
+        }
+    }
+
+    /**
+     * Encodes {@code count} UUIDs as consecutive 22 symbols long words without delimiters.
+     */
+    public static void encode(UUID[] src, int srcOff, int count, byte[] dst, int dstOff) {
+        Objects.checkFromIndexSize(srcOff, count, src.length);
+        Objects.checkFromIndexSize(dstOff, Math.multiplyExact(count, 2 * ENCODED_LONG_LENGTH), dst.length);
+        for (int i = 0; i < count; ++i) {
+            encode(src[srcOff + i], dst, dstOff + i * 2 * ENCODED_LONG_LENGTH);
+        }
+    }
+
     public static String encodeToString(UUID uuid) {
         return new String(encode(uuid), StandardCharsets.US_ASCII);
     }
 
     public static long calcEncodedLength(int plainLength) {
+        return calcEncodedLength((long)plainLength);
+    }
+
+    public static long calcEncodedLength(long plainLength) {
         if (plainLength <= 0) {
             if (plainLength == 0) {
                 return 0;
@@ -101,13 +206,78 @@ public final class Encoder {
                 throw new IllegalArgumentException("plainLength < 0");
             }
         }
-        long encodedLength = (long) ENCODED_LONG_LENGTH * (plainLength / Long.BYTES)
-                + PLAIN_TO_ENCODED_LENGTH_MAPPING[plainLength % Long.BYTES];
+        long encodedLength = ENCODED_LONG_LENGTH * (plainLength / Long.BYTES)
+                + PLAIN_TO_ENCODED_LENGTH_MAPPING[(int)(plainLength % Long.BYTES)];
         long lineSeparators = (encodedLength - 1) / ENCODED_LONG_LENGTH / ENCODED_LONGS_PER_LINE;
         return encodedLength + lineSeparators;
     }
 
+    /**
+     * Encodes {@code src[srcOff, srcOff + srcLen)} into {@code dst} starting at {@code dstOff}.
+     * @return number of written bytes which is {@link #calcEncodedLength(int)}
+     */
+    public static int encode(byte[] src, int srcOff, int srcLen, byte[] dst, int dstOff) {
+        Objects.checkFromIndexSize(srcOff, srcLen, src.length);
+        Objects.checkFromToIndex(dstOff, dst.length, dst.length);
+        if (calcEncodedLength(srcLen) > dst.length - dstOff) {
+            throw new IndexOutOfBoundsException("dst is too short for the encoded data");
+        }
+        if (NativeBackend.accepts(srcLen)) {
+            int written = NativeBackend.encodeArray(src, srcOff, srcLen, dst, dstOff);
+            if (written >= 0) {
+                return written;
+            }
+        }
+        return encodeArrays(src, srcOff, srcLen, dst, dstOff);
+    }
+
+    static int encodeArrays(byte[] src, int srcOff, int srcLen, byte[] dst, int dstOff) {
+        int i = srcOff;
+        int end = srcOff + srcLen;
+        int o = dstOff;
+        while (end - i > DECODED_LINE_LENGTH) {
+            for (int n = 0; n < ENCODED_LONGS_PER_LINE; ++n) {
+                encode((long)LITTLE_ENDIAN_LONG.get(src, i), dst, o);
+                i += Long.BYTES;
+                o += ENCODED_LONG_LENGTH;
+            }
+            dst[o++] = (byte)'\n';
+        }
+        while (end - i >= Long.BYTES) {
+            encode((long)LITTLE_ENDIAN_LONG.get(src, i), dst, o);
+            i += Long.BYTES;
+            o += ENCODED_LONG_LENGTH;
+        }
+        if (i < end) {
+            o += encodeRemaining(src, i, end - i, dst, o);
+        }
+        return o - dstOff;
+    }
+
     public static void encode(ByteBuffer src, ByteBuffer dst) {
+        if (NativeBackend.accepts(src, dst)) {
+            if (calcEncodedLength(src.remaining()) > dst.remaining()) {
+                throw new BufferOverflowException();
+            }
+            int written = NativeBackend.encode(src, src.position(), src.remaining(), dst, dst.position());
+            if (written >= 0) {
+                src.position(src.limit());
+                dst.position(dst.position() + written);
+                return;
+            }
+        }
+        if (src.hasArray() && dst.hasArray()) {
+            if (calcEncodedLength(src.remaining()) > dst.remaining()) {
+                throw new BufferOverflowException();
+            }
+            int written = encode(
+                    src.array(), src.arrayOffset() + src.position(), src.remaining(),
+                    dst.array(), dst.arrayOffset() + dst.position()
+            );
+            src.position(src.limit());
+            dst.position(dst.position() + written);
+            return;
+        }
         src.order(ByteOrder.LITTLE_ENDIAN);
         while (src.remaining() > DECODED_LINE_LENGTH) {
             for (int i = 0; i < ENCODED_LONGS_PER_LINE; i += 1) {
@@ -131,7 +301,12 @@ public final class Encoder {
             );
         }
         byte[] result = new byte[(int)encodedLength];
-        encode(src, ByteBuffer.wrap(result));
+        if (src.hasArray()) {
+            encode(src.array(), src.arrayOffset() + src.position(), src.remaining(), result, 0);
+            src.position(src.limit());
+        } else {
+            encode(src, ByteBuffer.wrap(result));
+        }
         return result;
     }
 
@@ -143,21 +318,238 @@ public final class Encoder {
         assert src.remaining() < Long.BYTES : src.remaining();
         int length = src.remaining();
         long n = 0;
-        int shift = 0;
+        int bits = 0;
         while (src.hasRemaining()) {
-            n |= ((long)src.get() & 0xFF) << shift;
-            shift += 8;
+            n |= ((long)src.get() & 0xFF) << bits;
+            bits += 8;
         }
-        byte[] buffer = encode(n);
+        int value = 0;
+        int shift = 0;
         for (int i = 0; i < PLAIN_TO_ENCODED_LENGTH_MAPPING[length]; i += 1) {
-            dst.put(buffer[i]);
+            if ((SHIFTED_POSITIONS >>> i & 1) != 0) {
+                shift += value + 1;
+                value = (int)Long.remainderUnsigned(n, 56);
+                n = Long.divideUnsigned(n, 56);
+            } else {
+                value = (int)Long.remainderUnsigned(n, 57);
+                n = Long.divideUnsigned(n, 57);
+            }
+            dst.put(SYMBOLS[shift + value]);
         }
     }
 
+    static int encodeRemaining(byte[] src, int srcOff, int length, byte[] dst, int dstOff) {
+        assert length < Long.BYTES : length;
+        long n = 0;
+        for (int i = 0; i < length; i += 1) {
+            n |= ((long)src[srcOff + i] & 0xFF) << (8 * i);
+        }
+        int encodedLength = PLAIN_TO_ENCODED_LENGTH_MAPPING[length];
+        int value = 0;
+        int shift = 0;
+        for (int i = 0; i < encodedLength; i += 1) {
+            if ((SHIFTED_POSITIONS >>> i & 1) != 0) {
+                shift += value + 1;
+                value = (int)Long.remainderUnsigned(n, 56);
+                n = Long.divideUnsigned(n, 56);
+            } else {
+                value = (int)Long.remainderUnsigned(n, 57);
+                n = Long.divideUnsigned(n, 57);
+            }
+            dst[dstOff + i] = SYMBOLS[shift + value];
+        }
+        return encodedLength;
+    }
+
     public static OutputStream wrap(OutputStream os) {
         return new EncodingOutputStream(os);
     }
 
+    public static WritableByteChannel wrap(WritableByteChannel channel) {
+        return new EncodingChannel(channel);
+    }
+
+    /**
+     * Encodes everything from {@code src} into {@code dst}, neither of them is closed.
+     * @return number of plain bytes read
+     */
+    public static long encode(ReadableByteChannel src, WritableByteChannel dst) throws IOException {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(EncodingChannel.BUFFERED_LINES * DECODED_LINE_LENGTH);
+        long total = 0;
+        EncodingChannel encodingChannel = new EncodingChannel(dst);
+        int read;
+        while ((read = src.read(buffer)) >= 0) {
+            total += read;
+            buffer.flip();
+            encodingChannel.write(buffer);
+            buffer.clear();
+        }
+        encodingChannel.finish();
+        return total;
+    }
+
+    /**
+     * Encodes {@code src} file into {@code dst} file through memory mappings.
+     * Files are mapped in chunks of whole lines, so there is no size limit.
+     */
+    public static void encodeFile(Path src, Path dst) throws IOException {
+        encodeFile(src, dst, MAPPED_LINES);
+    }
+
+    /** Maps files in chunks of {@code mappedLines} lines. */
+    static void encodeFile(Path src, Path dst, long mappedLines) throws IOException {
+        try (
+            FileChannel in = FileChannel.open(src, StandardOpenOption.READ);
+            FileChannel out = FileChannel.open(
+                    dst, StandardOpenOption.READ, StandardOpenOption.WRITE,
+                    StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING
+            )
+        ) {
+            long plainLength = in.size();
+            long encodedLength = calcEncodedLength(plainLength);
+            long plainPosition = 0;
+            long encodedPosition = 0;
+            while (plainPosition < plainLength) {
+                long plainChunk = Math.min(mappedLines * DECODED_LINE_LENGTH, plainLength - plainPosition);
+                boolean last = plainPosition + plainChunk == plainLength;
+                long encodedChunk = last
+                        ? encodedLength - encodedPosition
+                        : plainChunk / DECODED_LINE_LENGTH * ENCODED_LINE_LENGTH;
+                MappedByteBuffer plain = in.map(FileChannel.MapMode.READ_ONLY, plainPosition, plainChunk);
+                MappedByteBuffer encoded = out.map(FileChannel.MapMode.READ_WRITE, encodedPosition, encodedChunk);
+                encode(plain, encoded);
+                if (!last) {
+                    encoded.put((byte)'\n');
+                }
+                assert !encoded.hasRemaining() : encoded.remaining();
+                plainPosition += plainChunk;
+                encodedPosition += encodedChunk;
+            }
+        }
+    }
+
+    static final long MAPPED_LINES = 1 << 20;
+
+    static long getLittleEndianLong(ByteBuffer src) {
+        long n = src.getLong();
+        return src.order() == ByteOrder.LITTLE_ENDIAN ? n : Long.reverseBytes(n);
+    }
+
+    /**
+     * Buffers encoded lines and writes them in batches.
+     * Lines are encoded straight from a source buffer when possible.
+     */
+    public static final class EncodingChannel implements WritableByteChannel {
+
+        static final int BUFFERED_LINES = 1024;
+
+        final WritableByteChannel channel;
+        final ByteBuffer inputBuffer = ByteBuffer.allocateDirect(DECODED_LINE_LENGTH);
+        final ByteBuffer outputBuffer = ByteBuffer.allocateDirect(BUFFERED_LINES * ENCODED_LINE_LENGTH);
+        boolean open = true;
+        boolean finished = false;
+
+        public EncodingChannel(WritableByteChannel channel) {
+            this.channel = channel;
+            inputBuffer.order(ByteOrder.LITTLE_ENDIAN);
+        }
+
+        @Override
+        public int write(ByteBuffer src) throws IOException {
+            if (!open) {
+                throw new ClosedChannelException();
+            }
+            if (finished) {
+                throw new IllegalStateException("Encoding has been finished.");
+            }
+            int written = src.remaining();
+            while (src.hasRemaining()) {
+                if (inputBuffer.position() == 0 && src.remaining() > DECODED_LINE_LENGTH) {
+                    encodeLine(src);
+                    continue;
+                }
+                if (!inputBuffer.hasRemaining()) {
+                    inputBuffer.flip();
+                    encodeLine(inputBuffer);
+                    inputBuffer.clear();
+                    continue;
+                }
+                int chunk = Math.min(inputBuffer.remaining(), src.remaining());
+                int limit = src.limit();
+                src.limit(src.position() + chunk);
+                inputBuffer.put(src);
+                src.limit(limit);
+            }
+            return written;
+        }
+
+        /** Writes all buffered lines to the underlying channel. */
+        public void flush() throws IOException {
+            outputBuffer.flip();
+            while (outputBuffer.hasRemaining()) {
+                channel.write(outputBuffer);
+            }
+            outputBuffer.clear();
+        }
+
+        @Override
+        public boolean isOpen() {
+            return open && channel.isOpen();
+        }
+
+        @Override
+        public void close() throws IOException {
+            if (!open) {
+                return;
+            }
+            open = false;
+            try {
+                finish();
+            } finally {
+                channel.close();
+            }
+        }
+
+        /**
+         * Encodes and writes buffered data including the last partial line
+         * without closing the underlying channel. No more data can be written afterwards.
+         */
+        public void finish() throws IOException {
+            if (finished) {
+                return;
+            }
+            finished = true;
+            try {
+                inputBuffer.flip();
+                if (outputBuffer.remaining() < ENCODED_LINE_LENGTH) {
+                    flush();
+                }
+                while (inputBuffer.remaining() >= Long.BYTES) {
+                    encode(inputBuffer.getLong(), outputBuffer);
+                }
+                if (inputBuffer.hasRemaining()) {
+                    encodeRemaining(inputBuffer, outputBuffer);
+                }
+                flush();
+            } finally {
+                inputBuffer.clear();
+                while (inputBuffer.hasRemaining()) {
+                    inputBuffer.putLong(0); // clears potentially sensitive data
+                }
+            }
+        }
+
+        void encodeLine(ByteBuffer src) throws IOException {
+            if (outputBuffer.remaining() < ENCODED_LINE_LENGTH) {
+                flush();
+            }
+            for (int n = 0; n < ENCODED_LONGS_PER_LINE; ++n) {
+                encode(getLittleEndianLong(src), outputBuffer);
+            }
+            outputBuffer.put((byte)'\n');
+        }
+    }
+
     public static final class EncodingOutputStream extends FilterOutputStream {
 
         final ByteBuffer inputBuffer = ByteBuffer.allocate(DECODED_LINE_LENGTH);
@@ -0,0 +1,53 @@
+package tech.surdacki.base57;
+
+import java.nio.ByteBuffer;
+
+
+/**
+ * Optional bindings to the C implementation built as the {@code base57jni} library.
+ * The library is looked up in {@code java.library.path} and may be disabled
+ * with {@code -Dtech.surdacki.base57.native=false}.
+ * Payloads shorter than {@code -Dtech.surdacki.base57.nativeThreshold} bytes stay in Java
+ * because crossing the JNI boundary does not pay off for them.
+ * Native calls return -1 when the pure Java code has to take over, e.g. on an invalid symbol
+ * or a too small destination, so the Java code reports errors in both cases.
+ * Native decoding declines everything the Java decoder rejects, including ASCII separators
+ * 0x1C-0x1F which the C decoder alone takes for delimiters.
+ */
+final class NativeBackend {
+    static final boolean AVAILABLE = load();
+    static final int THRESHOLD = Integer.getInteger("tech.surdacki.base57.nativeThreshold", 1024);
+
+    private NativeBackend() {
+    }
+
+    static boolean accepts(int length) {
+        return AVAILABLE && length >= THRESHOLD;
+    }
+
+    static boolean accepts(ByteBuffer src, ByteBuffer dst) {
+        return accepts(src.remaining()) && src.isDirect() && dst.isDirect() && !dst.isReadOnly();
+    }
+
+    static native int encode(ByteBuffer src, int srcPosition, int srcLength, ByteBuffer dst, int dstPosition);
+
+    static native int decode(
+            ByteBuffer src, int srcPosition, int srcLength, ByteBuffer dst, int dstPosition, int dstLength
+    );
+
+    static native int encodeArray(byte[] src, int srcOff, int srcLength, byte[] dst, int dstOff);
+
+    static native int decodeArray(byte[] src, int srcOff, int srcLength, byte[] dst, int dstOff, int dstLength);
+
+    private static boolean load() {
+        if (!Boolean.parseBoolean(System.getProperty("tech.surdacki.base57.native", "true"))) {
+            return false;
+        }
+        try {
+            System.loadLibrary("base57jni");
+            return true;
+        } catch (UnsatisfiedLinkError | SecurityException e) {
+            return false;
+        }
+    }
+}
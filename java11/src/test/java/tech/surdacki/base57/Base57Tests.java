@@ -1,12 +1,21 @@
 package tech.surdacki.base57;
 
 import static org.junit.jupiter.api.Assertions.*;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
 
 import org.junit.jupiter.api.DynamicTest;
 import org.junit.jupiter.api.TestFactory;
+import org.junit.jupiter.api.io.TempDir;
 
 import java.io.*;
+import java.nio.BufferOverflowException;
 import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.ReadableByteChannel;
+import java.nio.channels.WritableByteChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.charset.StandardCharsets;
 import java.util.*;
 
 
@@ -63,6 +72,40 @@ public final class Base57Tests {
         }
     }
 
+    @org.junit.jupiter.api.Test
+    void testLongBatches() {
+        Random prng = new Random(0x5B1C7E3A9D24F068L);
+        long[] plain = new long[DEFAULT_TESTS_NUMBER];
+        for (int i = 0; i < plain.length; ++i) {
+            plain[i] = prng.nextLong();
+        }
+        byte[] encoded = new byte[1 + plain.length * Constants.ENCODED_LONG_LENGTH];
+        Encoder.encode(plain, 0, plain.length, encoded, 1);
+        long[] decoded = new long[plain.length + 1];
+        Decoder.decode(encoded, 1, decoded, 1, plain.length);
+        for (int i = 0; i < plain.length; ++i) {
+            assertEquals(Encoder.encodeToString(plain[i]), new String(
+                    encoded, 1 + i * Constants.ENCODED_LONG_LENGTH, Constants.ENCODED_LONG_LENGTH,
+                    StandardCharsets.US_ASCII
+            ));
+            assertEquals(plain[i], decoded[i + 1]);
+        }
+    }
+
+    @org.junit.jupiter.api.Test
+    void testUuidBatches() {
+        Random prng = new Random(0x0E97A4C2D8B61F35L);
+        UUID[] plain = new UUID[DEFAULT_TESTS_NUMBER];
+        for (int i = 0; i < plain.length; ++i) {
+            plain[i] = new UUID(prng.nextLong(), prng.nextLong());
+        }
+        byte[] encoded = new byte[plain.length * 2 * Constants.ENCODED_LONG_LENGTH];
+        Encoder.encode(plain, 0, plain.length, encoded, 0);
+        UUID[] decoded = new UUID[plain.length];
+        Decoder.decode(encoded, 0, decoded, 0, plain.length);
+        assertArrayEquals(plain, decoded);
+    }
+
     @org.junit.jupiter.api.Test
     void testIntegersInvalidDecoding() {
         assertDoesNotThrow(() -> Decoder.decodeLong("ZZZZZZZZZZZ"));
@@ -82,6 +125,35 @@ public final class Base57Tests {
         assertDoesNotThrow(() -> Decoder.decodeLong("XWXWXWVVUVU"));
     }
 
+    @org.junit.jupiter.api.Test
+    void testNonCanonicalTails() throws IOException {
+        // a repeated symbol at a base 56 position, decoded as by the C library
+        assertTailDecoding(new byte[] { 0x38 }, "XX");
+        assertTailDecoding(new byte[] { 0x02 }, "22");
+    }
+
+    private static void assertTailDecoding(byte[] expected, String encoded) throws IOException {
+        byte[] bytes = encoded.getBytes(StandardCharsets.US_ASCII);
+        assertArrayEquals(expected, Decoder.decode(encoded));
+        byte[] decoded = new byte[expected.length];
+        assertEquals(expected.length, Decoder.decodeArrays(bytes, 0, bytes.length, decoded, 0, decoded.length));
+        assertArrayEquals(expected, decoded);
+
+        ByteBuffer directEncoded = ByteBuffer.allocateDirect(bytes.length).put(bytes).flip();
+        ByteBuffer directDecoded = ByteBuffer.allocateDirect(Decoder.calcDecodedMaxLength(bytes.length));
+        Decoder.decode(directEncoded, directDecoded);
+        assertEquals(ByteBuffer.wrap(expected), directDecoded.flip());
+
+        ReadableByteChannel channel = Decoder.wrap(Channels.newChannel(new ByteArrayInputStream(bytes)));
+        ByteBuffer channelDecoded = ByteBuffer.allocate(64);
+        while (channel.read(channelDecoded) >= 0) {
+            continue;
+        }
+        assertEquals(ByteBuffer.wrap(expected), channelDecoded.flip());
+
+        assertArrayEquals(expected, Decoder.wrap(new ByteArrayInputStream(bytes)).readAllBytes());
+    }
+
     @TestFactory
     Collection<DynamicTest> testShortRandomBytes() {
         List<DynamicTest> tests = new ArrayList<>(DEFAULT_TESTS_NUMBER);
@@ -123,6 +195,134 @@ public final class Base57Tests {
         assertArrayEquals(plain, decoded);
     }
 
+    @TestFactory
+    Collection<DynamicTest> testOffsetAndDirectBuffers() {
+        List<DynamicTest> tests = new ArrayList<>(DEFAULT_TESTS_NUMBER);
+        Random prng = new Random(0x6C3F10A8E5B7D294L);
+        for (int plainSize = 0; plainSize < DEFAULT_TESTS_NUMBER; ++plainSize) {
+            int finalPlainSize = plainSize;
+            tests.add(DynamicTest.dynamicTest(
+                    "plain size of "  + finalPlainSize + " bytes",
+                    () -> testOffsetAndDirectBuffers(prng, finalPlainSize))
+            );
+        }
+        return tests;
+    }
+
+    private void testOffsetAndDirectBuffers(Random prng, int plainSize) {
+        byte[] plain = new byte[plainSize];
+        prng.nextBytes(plain);
+        byte[] expected = Encoder.encode(ByteBuffer.wrap(plain));
+
+        byte[] source = new byte[plainSize + 3];
+        System.arraycopy(plain, 0, source, 3, plainSize);
+        byte[] encoded = new byte[expected.length + 5];
+        assertEquals(expected.length, Encoder.encode(source, 3, plainSize, encoded, 5));
+        assertArrayEquals(expected, Arrays.copyOfRange(encoded, 5, encoded.length));
+        byte[] decoded = new byte[plainSize + 7];
+        assertEquals(plainSize, Decoder.decode(encoded, 5, expected.length, decoded, 7));
+        assertArrayEquals(plain, Arrays.copyOfRange(decoded, 7, decoded.length));
+
+        ByteBuffer directPlain = ByteBuffer.allocateDirect(plainSize).put(plain).flip();
+        ByteBuffer directEncoded = ByteBuffer.allocateDirect(expected.length);
+        Encoder.encode(directPlain, directEncoded);
+        assertEquals(ByteBuffer.wrap(expected), directEncoded.flip());
+        ByteBuffer directDecoded = ByteBuffer.allocateDirect(plainSize);
+        Decoder.decode(directEncoded, directDecoded);
+        assertEquals(ByteBuffer.wrap(plain), directDecoded.flip());
+
+        ByteBuffer exactDecoded = ByteBuffer.allocate(plainSize);
+        Decoder.decode(ByteBuffer.wrap(expected), exactDecoded);
+        assertEquals(ByteBuffer.wrap(plain), exactDecoded.flip());
+        if (plainSize > 0) {
+            assertThrows(BufferOverflowException.class,
+                    () -> Decoder.decode(ByteBuffer.wrap(expected), ByteBuffer.allocate(plainSize - 1)));
+            assertThrows(IndexOutOfBoundsException.class,
+                    () -> Decoder.decode(expected, 0, expected.length, new byte[plainSize - 1], 0));
+        }
+    }
+
+    @TestFactory
+    Collection<DynamicTest> testNativeBackend() {
+        List<DynamicTest> tests = new ArrayList<>(LIMITED_TESTS_NUMBER);
+        Random prng = new Random(0x2A4E86C1F09B3D57L);
+        for (int t = 0; t < LIMITED_TESTS_NUMBER; ++t) {
+            int plainSize = t < LIMITED_TESTS_NUMBER / 2 ? t : prng.nextInt(BLOB_MAX_SIZE / 32);
+            tests.add(DynamicTest.dynamicTest(
+                    "plain size of "  + plainSize + " bytes",
+                    () -> testNativeBackend(prng, plainSize))
+            );
+        }
+        return tests;
+    }
+
+    private void testNativeBackend(Random prng, int plainSize) {
+        if (Boolean.getBoolean("tech.surdacki.base57.requireNative")) {
+            assertTrue(NativeBackend.AVAILABLE, "base57jni library is not in java.library.path");
+        }
+        assumeTrue(NativeBackend.AVAILABLE, "base57jni library is not available");
+        byte[] plain = new byte[plainSize];
+        prng.nextBytes(plain);
+        byte[] expected = new byte[(int)Encoder.calcEncodedLength(plainSize)];
+        Encoder.encodeArrays(plain, 0, plainSize, expected, 0);
+
+        byte[] encoded = new byte[expected.length];
+        assertEquals(expected.length, NativeBackend.encodeArray(plain, 0, plainSize, encoded, 0));
+        assertArrayEquals(expected, encoded);
+        byte[] decoded = new byte[plainSize];
+        assertEquals(plainSize, NativeBackend.decodeArray(encoded, 0, encoded.length, decoded, 0, plainSize));
+        assertTrue(Arrays.equals(plain, 0, plainSize, decoded, 0, plainSize));
+
+        ByteBuffer directPlain = ByteBuffer.allocateDirect(plainSize).put(plain).flip();
+        ByteBuffer directEncoded = ByteBuffer.allocateDirect(expected.length);
+        assertEquals(expected.length, NativeBackend.encode(directPlain, 0, plainSize, directEncoded, 0));
+        assertEquals(ByteBuffer.wrap(expected), directEncoded);
+        ByteBuffer directDecoded = ByteBuffer.allocateDirect(Decoder.calcDecodedMaxLength(expected.length));
+        assertEquals(plainSize, NativeBackend.decode(
+                directEncoded, 0, expected.length, directDecoded, 0, directDecoded.capacity()
+        ));
+        assertEquals(ByteBuffer.wrap(plain), directDecoded.limit(plainSize));
+
+        byte[] javaDecoded = new byte[plainSize];
+        assertEquals(plainSize, Decoder.decodeArrays(expected, 0, expected.length, javaDecoded, 0, plainSize));
+        assertArrayEquals(plain, javaDecoded);
+        assertEquals(-1, NativeBackend.decodeArray(new byte[] { '0' }, 0, 1, decoded, 0, decoded.length));
+        if (plainSize > 0) {
+            assertEquals(-1, NativeBackend.decodeArray(encoded, 0, encoded.length, decoded, 0, plainSize - 1));
+        }
+
+        // both backends accept and reject the same delimiters and decode the same tails
+        for (byte separator : new byte[] { 0x1C, 0x1D, 0x1E, 0x1F, '<', '=', '>', '~' }) {
+            byte[] separated = Arrays.copyOf(encoded, encoded.length + 1);
+            separated[encoded.length] = separator;
+            assertEquals(-1, NativeBackend.decodeArray(separated, 0, separated.length, decoded, 0, plainSize));
+            assertCrossChecked(separated);
+        }
+        for (String tail : new String[] { "XW", "XX", "22" }) { // "XX" and "22" are not canonical
+            assertCrossChecked(tail.getBytes(StandardCharsets.US_ASCII));
+        }
+        assertCrossChecked(encoded);
+    }
+
+    private static void assertCrossChecked(byte[] encoded) {
+        byte[] javaDecoded = new byte[Decoder.calcDecodedMaxLength(encoded.length)];
+        byte[] nativeDecoded = new byte[javaDecoded.length];
+        int javaWritten;
+        try {
+            javaWritten = Decoder.decodeArrays(encoded, 0, encoded.length, javaDecoded, 0, javaDecoded.length);
+        } catch (IllegalArgumentException e) {
+            assertEquals(-1, NativeBackend.decodeArray(encoded, 0, encoded.length, nativeDecoded, 0, nativeDecoded.length));
+            assertThrows(IllegalArgumentException.class, () -> Decoder.decode(ByteBuffer.wrap(encoded)));
+            return;
+        }
+        int nativeWritten = NativeBackend.decodeArray(encoded, 0, encoded.length, nativeDecoded, 0, nativeDecoded.length);
+        if (nativeWritten >= 0) {
+            assertEquals(javaWritten, nativeWritten);
+            assertArrayEquals(javaDecoded, nativeDecoded);
+        }
+        assertArrayEquals(Arrays.copyOf(javaDecoded, javaWritten), Decoder.decode(ByteBuffer.wrap(encoded)));
+    }
+
     @TestFactory
     Collection<DynamicTest> testShortStreams() {
         List<DynamicTest> tests = new ArrayList<>(LIMITED_TESTS_NUMBER);
@@ -178,4 +378,119 @@ public final class Base57Tests {
         assertEquals(plainSize, i);
         assertTrue(Arrays.equals(plain, 0, plain.length, decoded, 0, i));
     }
+
+    @TestFactory
+    Collection<DynamicTest> testChannels() {
+        List<DynamicTest> tests = new ArrayList<>(LIMITED_TESTS_NUMBER);
+        Random prng = new Random(0x4F92B0D63A1E7C85L);
+        for (int t = 0; t < LIMITED_TESTS_NUMBER; ++t) {
+            int plainSize = t < LIMITED_TESTS_NUMBER / 2 ? t : prng.nextInt(BLOB_MAX_SIZE / 8);
+            tests.add(DynamicTest.dynamicTest(
+                "channel of size " + plainSize, () -> testRandomChannel(prng, plainSize)
+            ));
+        }
+        return tests;
+    }
+
+    private void testRandomChannel(Random prng, int plainSize) throws IOException {
+        byte[] plain = new byte[plainSize];
+        prng.nextBytes(plain);
+        ByteArrayOutputStream os = new ByteArrayOutputStream();
+        WritableByteChannel ec = Encoder.wrap(Channels.newChannel(os));
+        int i = 0;
+        while (i < plainSize) {
+            int length = prng.nextInt(Math.min(CHUNK, plain.length - i + 1));
+            ec.write(ByteBuffer.wrap(plain, i, length));
+            i += length;
+        }
+        ec.close();
+        assertArrayEquals(Encoder.encode(ByteBuffer.wrap(plain)), os.toByteArray());
+
+        ReadableByteChannel dc = Decoder.wrap(Channels.newChannel(new ByteArrayInputStream(os.toByteArray())));
+        ByteBuffer decoded = ByteBuffer.allocate(plainSize + CHUNK);
+        while (decoded.position() < plainSize) {
+            int length = prng.nextInt(CHUNK + 1);
+            decoded.limit(decoded.position() + length);
+            assertTrue(dc.read(decoded) >= 0);
+        }
+        decoded.limit(decoded.capacity());
+        assertEquals(-1, dc.read(decoded));
+        dc.close();
+        assertEquals(ByteBuffer.wrap(plain), decoded.flip());
+    }
+
+    @org.junit.jupiter.api.Test
+    void testFiles(@TempDir Path directory) throws IOException {
+        Random prng = new Random(0x18E3C7A5D0F29B64L);
+        for (int plainSize : new int[] { 0, 1, 63, 64, 65, 1000003 }) {
+            byte[] plain = new byte[plainSize];
+            prng.nextBytes(plain);
+            Path plainFile = Files.write(directory.resolve("plain"), plain);
+            Path encodedFile = directory.resolve("encoded");
+            Path decodedFile = directory.resolve("decoded");
+            Encoder.encodeFile(plainFile, encodedFile);
+            assertArrayEquals(Encoder.encode(ByteBuffer.wrap(plain)), Files.readAllBytes(encodedFile));
+            Decoder.decodeFile(encodedFile, decodedFile);
+            assertArrayEquals(plain, Files.readAllBytes(decodedFile));
+        }
+    }
+
+    @org.junit.jupiter.api.Test
+    void testFileMappingBoundaries(@TempDir Path directory) throws IOException {
+        Random prng = new Random(0x5B0D4E7A13C96F28L);
+        Path plainFile = directory.resolve("plain");
+        Path encodedFile = directory.resolve("encoded");
+        Path decodedFile = directory.resolve("decoded");
+        for (int mappedLines = 1; mappedLines <= 3; ++mappedLines) {
+            int mappedSize = mappedLines * Constants.DECODED_LINE_LENGTH;
+            for (int boundary = mappedSize; boundary <= 3 * mappedSize; boundary += mappedSize) {
+                for (int plainSize = boundary - 1; plainSize <= boundary + 1; ++plainSize) {
+                    byte[] plain = new byte[plainSize];
+                    prng.nextBytes(plain);
+                    Files.write(plainFile, plain);
+                    Encoder.encodeFile(plainFile, encodedFile, mappedLines);
+                    byte[] encoded = Encoder.encode(ByteBuffer.wrap(plain));
+                    assertArrayEquals(encoded, Files.readAllBytes(encodedFile));
+
+                    int half = encoded.length / 2;
+                    long[] mappedChunkSizes = {
+                        1, Constants.ENCODED_LONG_LENGTH, Constants.ENCODED_LINE_LENGTH,
+                        Constants.ENCODED_LINE_LENGTH + 1, half - 1, half, half + 1
+                    };
+                    for (long mappedChunkSize : mappedChunkSizes) {
+                        Decoder.decodeFile(encodedFile, decodedFile, mappedChunkSize);
+                        assertArrayEquals(plain, Files.readAllBytes(decodedFile), "chunk " + mappedChunkSize);
+                    }
+                }
+            }
+        }
+    }
+
+    @org.junit.jupiter.api.Test
+    void testChannelsStayOpen() throws IOException {
+        byte[] plain = new byte[3 * Constants.DECODED_LINE_LENGTH + 5];
+        new Random(0x2C7E91B4F06A3D85L).nextBytes(plain);
+        ByteArrayOutputStream os = new ByteArrayOutputStream();
+        WritableByteChannel encodedChannel = Channels.newChannel(os);
+        Encoder.EncodingChannel ec = new Encoder.EncodingChannel(encodedChannel);
+        ec.write(ByteBuffer.wrap(plain));
+        ec.finish();
+        assertTrue(encodedChannel.isOpen());
+        assertThrows(IllegalStateException.class, () -> ec.write(ByteBuffer.wrap(plain)));
+        byte[] encoded = Encoder.encode(ByteBuffer.wrap(plain));
+        assertArrayEquals(encoded, os.toByteArray());
+        ec.close();
+        assertFalse(encodedChannel.isOpen());
+
+        os.reset();
+        WritableByteChannel dst = Channels.newChannel(os);
+        assertEquals(plain.length, Encoder.encode(Channels.newChannel(new ByteArrayInputStream(plain)), dst));
+        assertTrue(dst.isOpen());
+        assertArrayEquals(encoded, os.toByteArray());
+
+        os.reset();
+        assertEquals(plain.length, Decoder.decode(Channels.newChannel(new ByteArrayInputStream(encoded)), dst));
+        assertTrue(dst.isOpen());
+        assertArrayEquals(plain, os.toByteArray());
+    }
 }